@@ -41,8 +41,10 @@
 
 #ifdef LEDA_GE_V5
 #include <LEDA/numbers/integer.h>
+#include <LEDA/system/error.h>
 #else
 #include <LEDA/integer.h>
+#include <LEDA/error.h>
 #endif
 
 namespace mcb { 
@@ -65,6 +67,114 @@ inline int compare(const ptype& x, const ptype& y)
     else return 0;                                     
 } 
 
+/* Primes which fit in a machine word use 64-bit arithmetic with 128-bit 
+ * intermediates, whenever the compiler provides them.
+ */
+#if defined(__SIZEOF_INT128__)
+#define MCB_LEP_WORD_PRIMES
+#endif
+
+#ifdef MCB_LEP_WORD_PRIMES
+
+/*! The prime type used for the directed cycle basis algorithm, when the 
+ *  prime fits in a machine word.
+ */
+__extension__ typedef long long wptype;
+
+// give compare for wptype inside mcb namespace
+inline int compare(const wptype& x, const wptype& y)  
+{ 
+    if (x < y) return -1;                              
+    else if (x > y) return 1;                          
+    else return 0;                                     
+} 
+
+namespace detail { 
+
+    /*! Arithmetic modulo a prime \f$p < 2^{62}\f$ using Barrett reduction. 
+     *  All elements are in \f$[0,p)\f$.
+     */
+    class barrett 
+    { 
+        public:
+            barrett( wptype p_ ) : p( p_ ), k( 0 ) 
+            { 
+                while( ( p >> k ) != 0 ) ++k;
+                mu = (word) ( ( (dword) 1 << ( 2 * k ) ) / p );
+            }
+
+            wptype prime() const { return (wptype) p; }
+
+            // reduce any value
+            wptype reduce( wptype a ) const { 
+                a %= (wptype) p;
+                return ( a < 0 ) ? a + (wptype) p : a;
+            }
+
+            wptype add( wptype a, wptype b ) const { 
+                word r = (word) a + (word) b;
+                return (wptype) ( ( r >= p ) ? r - p : r );
+            }
+
+            wptype sub( wptype a, wptype b ) const { 
+                return ( a >= b ) ? a - b : a + (wptype) p - b;
+            }
+
+            wptype mul( wptype a, wptype b ) const { 
+                dword x = (dword) (word) a * (word) b;
+                dword q = ( ( x >> ( k - 1 ) ) * mu ) >> ( k + 1 );
+                word r = (word) ( x - q * p );
+                while( r >= p ) r -= p;
+                return (wptype) r;
+            }
+
+            // multiplicative inverse of a non-zero element
+            wptype inverse( wptype a ) const { 
+                wptype r0 = (wptype) p, r1 = a, t0 = 0, t1 = 1;
+                while( r1 != 0 ) { 
+                    wptype q = r0 / r1, t;
+                    t = r0 - q * r1; r0 = r1; r1 = t;
+                    t = t0 - q * t1; t0 = t1; t1 = t;
+                }
+#if ! defined(LEDA_CHECKING_OFF)
+                if ( r0 != 1 )
+                    leda::error_handler(999, "MIN_CYCLE_BASIS: mult inverse does not exist");
+#endif
+                return ( t0 < 0 ) ? t0 + (wptype) p : t0;
+            }
+
+        private:
+            __extension__ typedef unsigned long long word;
+            __extension__ typedef unsigned __int128 dword;
+
+            word p;
+            int k;      // number of bits of p
+            word mu;    // floor( 2^(2k) / p )
+    };
+
+    /*! Whether a prime fits in a word, together with the indices 
+     *  \f$p \cdot n\f$ of the level graph of a graph with \f$n\f$ nodes.
+     */
+    inline bool fits_word( const ptype& p, int n ) 
+    { 
+        return sizeof( long ) >= sizeof( wptype ) && 
+            p.length() + ptype( n ).length() <= 62;
+    }
+
+    /*! Primality test by trial division, same as primes<T>::is_prime(). */
+    inline bool is_prime( wptype p ) 
+    { 
+        if ( p == 1 ) return true;
+        if ( p % 2 == 0 ) return false;
+        for( wptype t = 3; t <= p / t; t += 2 ) 
+            if ( p % t == 0 ) return false;
+        return true;
+    }
+
+} // namespace detail end
+
+#endif // MCB_LEP_WORD_PRIMES
+
 } // end of namespace mcb
 
 #endif // ARITHM_H
@@ -0,0 +1,254 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+/*! \file bitmatgf2.h
+ *  \brief Dense matrix with elements in GF2.
+ */
+
+#ifndef BITMATGF2_H
+#define BITMATGF2_H
+
+#include <vector>
+#include <LEP/mcb/config.h>
+
+#ifdef LEDA_GE_V5
+#include <LEDA/core/d_int_set.h>
+#else
+#include <LEDA/d_int_set.h>
+#endif
+
+#include <LEP/mcb/spvecgf2.h>
+
+#if defined(_MSC_VER)
+typedef unsigned __int64 mcb_uint64;
+#else
+#include <stdint.h>
+typedef uint64_t mcb_uint64;
+#endif
+
+namespace mcb
+{
+
+#if defined(LEDA_NAMESPACE)
+    using leda::d_int_set;
+#endif
+
+namespace detail
+{ 
+
+    /*! The word type used to pack vectors with elements in GF2. */
+    typedef mcb_uint64 gf2word;
+
+    /*! Number of bits in a gf2word. */
+    const int gf2word_bits = 64;
+
+    /*! \brief A dense matrix with elements in GF2.
+     *
+     *  Each row of the matrix is a bitset packed in 64-bit words and all rows are 
+     *  stored in one contiguous block of memory. Row operations are word parallel;
+     *  the inner product of two rows is the parity of the number of ones of their AND
+     *  and the sum of two rows is their XOR. 
+     *
+     *  Besides init() no operation allocates memory. The matrix uses 
+     *  \f$rows \cdot \lceil cols/64 \rceil\f$ words of memory.
+     *
+     *  On x86 processors the row operations use AVX-512 or AVX2 instructions if the 
+     *  processor supports them. The selection is performed at runtime and can be disabled
+     *  at compile time by defining MCB_LEP_NO_SIMD.
+     *
+     *  The undirected algorithms use this class to maintain the support vectors when 
+     *  mcb::DENSE_SUPPORT is requested. The support vectors have non-zero entries
+     *  only at the first \f$N\f$ indices, where \f$N\f$ is the dimension of the cycle
+     *  space, and thus a dense \f$N \times N\f$ matrix can hold all of them.
+     *
+     *  \date 2008
+     *  \author Dimitrios Michail
+     */
+    class bitmatgf2
+    {
+        public:
+            //@{
+            /*! Construct an empty matrix. */
+            bitmatgf2();
+
+            /*! Construct a zero matrix. 
+             *  \param rows The number of rows.
+             *  \param cols The number of columns.
+             */
+            bitmatgf2( int rows, int cols );
+
+            /*! Destructor */
+            ~bitmatgf2();
+            //@}
+
+            /*! Reinitialize as a zero matrix.
+             *  \param rows The number of rows.
+             *  \param cols The number of columns.
+             */
+            void init( int rows, int cols );
+
+            /*! Number of rows. */
+            int rows() const { return r; }
+
+            /*! Number of columns. */
+            int cols() const { return c; }
+
+            /*! Number of words used by each row. */
+            int words() const { return w; }
+
+            /*! Access the words of a row. */
+            gf2word* row( int i ) { return &a[0] + i * w; }
+
+            /*! Access the words of a row. */
+            const gf2word* row( int i ) const { return &a[0] + i * w; }
+
+            /*! Set entry \f$(i,j)\f$ to one. */
+            void set( int i, int j ) { 
+                row( i )[ j / gf2word_bits ] |= gf2word(1) << ( j % gf2word_bits ); 
+            }
+
+            /*! Get entry \f$(i,j)\f$. */
+            bool get( int i, int j ) const { 
+                return ( row( i )[ j / gf2word_bits ] >> ( j % gf2word_bits ) ) & 1; 
+            }
+
+            /*! Set all entries of a row to zero. */
+            void clear_row( int i );
+
+            /*! Exchange two rows. */
+            void swap_rows( int i, int j );
+
+            /*! Number of ones in row \f$i\f$. */
+            int count( int i ) const;
+
+            /*! Add row \f$j\f$ to row \f$i\f$.
+             *  \return The number of ones of row \f$i\f$ after the addition.
+             */
+            int add_row( int i, int j );
+
+            /*! Inner product of row \f$i\f$ with a packed vector.
+             *  \param i The row.
+             *  \param v A packed vector of words() words.
+             *  \return 0 or 1
+             */
+            int dot( int i, const gf2word* v ) const;
+
+            /*! Add row \f$k\f$ to every row \f$l\f$, \f$first \le l < last\f$, which
+             *  has inner product one with a packed vector. Each row is tested and updated
+             *  in the same pass.
+             *  \param first The first row.
+             *  \param last One past the last row.
+             *  \param v A packed vector of words() words.
+             *  \param k The row to add.
+             *  \param ones An array indexed by rows. The entry of each updated row is 
+             *               set to its number of ones.
+             *  \pre \f$k\f$ is not in \f$[first,last)\f$
+             */
+            void update_rows( int first, int last, const gf2word* v, int k, int* ones );
+
+            //@{
+            /*! Pack a sparse vector. Indices greater or equal to cols() are ignored.
+             *  \param v The sparse vector.
+             *  \param out Where to write the packed vector, must hold words() words.
+             */
+            void pack( const spvecgf2& v, gf2word* out ) const;
+
+            /*! Pack a compressed integer set. Indices greater or equal to cols() are ignored.
+             *  \param v The integer set.
+             *  \param out Where to write the packed vector, must hold words() words.
+             */
+            void pack( const d_int_set& v, gf2word* out ) const;
+            //@}
+
+            //@{
+            /*! Read row \f$i\f$ into a sparse vector. The indices are stored in increasing order. */
+            void get_row( int i, spvecgf2& v ) const;
+
+            /*! Read row \f$i\f$ into a compressed integer set. */
+            void get_row( int i, d_int_set& v ) const;
+            //@}
+
+        private:
+            int r, c, w;
+            std::vector<gf2word> a;
+    };
+
+    //@{
+    /*! Compute the parity of the number of ones of the AND of two packed vectors.
+     *  \param x The first vector.
+     *  \param y The second vector.
+     *  \param words The number of words of both vectors.
+     *  \return 0 or 1
+     */
+    int gf2_dot( const gf2word* x, const gf2word* y, int words );
+
+    /*! Add a packed vector to another, \f$x = x + y\f$.
+     *  \param x The vector to add to.
+     *  \param y The vector to add.
+     *  \param words The number of words of both vectors.
+     *  \return The number of ones of \f$x\f$ after the addition.
+     */
+    int gf2_add( gf2word* x, const gf2word* y, int words );
+
+    /*! Count the number of ones of a packed vector.
+     *  \param x The vector.
+     *  \param words The number of words of the vector.
+     *  \return The number of ones.
+     */
+    int gf2_count( const gf2word* x, int words );
+
+    /*! Fused test and update of consecutive packed vectors. Each vector \f$x_l\f$ 
+     *  with \f$x_l \cdot v = 1\f$ is replaced by \f$x_l + s\f$ and its number of 
+     *  ones is stored in ones[l]. 
+     *  \param rows The vectors, stored one after the other.
+     *  \param nrows The number of vectors.
+     *  \param words The number of words of each vector.
+     *  \param v The vector to test against.
+     *  \param s The vector to add.
+     *  \param ones Array of size nrows.
+     */
+    void gf2_update( gf2word* rows, int nrows, int words, 
+            const gf2word* v, const gf2word* s, int* ones );
+
+    /*! Name of the kernels selected for the current processor, one of "avx512", 
+     *  "avx2" or "generic". 
+     */
+    const char* gf2_kernel_name();
+    //@}
+
+} // namespace detail end
+
+} // namespace mcb end
+
+#endif  // BITMATGF2_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
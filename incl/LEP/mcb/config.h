@@ -46,9 +46,15 @@
 /* "Whether to output statistic information" */
 /* #undef LEP_STATS */
 
+/* "Whether to disable the SIMD kernels" */
+/* #undef MCB_LEP_NO_SIMD */
+
 /* "Whether to disable the exchange heuristic" */
 /* #undef MCB_LEP_UNDIR_NO_EXCHANGE_HEURISTIC */
 
+/* "Whether to disable the isometric cycles filter" */
+/* #undef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER */
+
 /* "Whether to disable the shortest paths heuristic" */
 /* #undef MCB_LEP_UNDIR_NO_SP_HEURISTIC */
 
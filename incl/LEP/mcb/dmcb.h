@@ -93,6 +93,13 @@
 #include <LEP/mcb/arithm.h>
 #include <LEP/mcb/transform.h>
 #include <LEP/mcb/dsigned.h>
+#include <LEP/mcb/support.h>
+#include <LEP/mcb/matfp.h>
+#include <LEP/mcb/count_ptr.h>
+#include <LEP/mcb/threads.h>
+
+#include <vector>
+#include <utility>
 
 namespace mcb { 
 
@@ -108,6 +115,310 @@ namespace mcb {
     using leda::pq_item;
 #endif
 
+#ifdef MCB_LEP_WORD_PRIMES
+    namespace detail { 
+
+        // a sparse vector modulo a word prime, (index,value) pairs sorted by index
+        typedef std::vector< std::pair< indextype, wptype > > wspvecfp;
+
+        // inner product
+        inline wptype dot( const wspvecfp& a, const wspvecfp& b, const barrett& F ) 
+        { 
+            wptype res = 0;
+            size_t i = 0, j = 0;
+            while( i < a.size() && j < b.size() ) { 
+                if ( a[i].first < b[j].first ) ++i;
+                else if ( a[i].first > b[j].first ) ++j;
+                else { 
+                    res = F.add( res, F.mul( a[i].second, b[j].second ) );
+                    ++i; ++j;
+                }
+            }
+            return res;
+        }
+
+        // x = x - c * y, using tmp as scratch space
+        inline void sub_multiple( wspvecfp& x, wptype c, const wspvecfp& y, 
+                const barrett& F, wspvecfp& tmp ) 
+        { 
+            tmp.clear();
+            size_t i = 0, j = 0;
+            while( i < x.size() || j < y.size() ) { 
+                if ( j == y.size() || ( i < x.size() && x[i].first < y[j].first ) ) 
+                    tmp.push_back( x[i++] );
+                else { 
+                    wptype v = F.mul( c, y[j].second );
+                    indextype index = y[j++].first;
+                    if ( i < x.size() && x[i].first == index ) 
+                        v = F.sub( x[i++].second, v );
+                    else 
+                        v = F.sub( 0, v );
+                    if ( v != 0 ) 
+                        tmp.push_back( std::make_pair( index, v ) );
+                }
+            }
+            x.swap( tmp );
+        }
+
+        // convert, using the representatives in (-p/2,p/2]
+        inline spvecfp to_spvecfp( const wspvecfp& x, const ptype& P, wptype p ) 
+        { 
+            spvecfp ret( P );
+            for( size_t i = 0; i < x.size(); ++i ) { 
+                wptype v = x[i].second;
+                ret.append( x[i].first, ptype( (long) ( ( v > p / 2 ) ? v - p : v ) ) );
+            }
+            return ret;
+        }
+
+        // The best weight among the finished trials of DMCB(), shared by the 
+        // threads which run the trials. 
+        template<class W>
+            class trial_bound
+            { 
+                public:
+                    trial_bound() : weight( W(0) ), infinite( true ) {}
+
+                    // whether a trial with this running total cannot be the best
+                    bool exceeded( const W& w ) { 
+                        bool ret;
+#ifdef _OPENMP
+#pragma omp critical(mcb_dmcb_trials)
+#endif
+                        ret = ( infinite == false && weight < w );
+                        return ret;
+                    }
+
+                    // a trial finished with this weight
+                    void update( const W& w ) { 
+#ifdef _OPENMP
+#pragma omp critical(mcb_dmcb_trials)
+#endif
+                        { 
+                            if ( infinite || w < weight ) { 
+                                weight = w;
+                                infinite = false;
+                            }
+                        }
+                    }
+
+                private:
+                    W weight;
+                    bool infinite;
+            };
+
+        // The algorithm of DMCB() for a prime which fits in a word. The cycles 
+        // are left in B and the proof in X. If a bound is given the trial is 
+        // abandoned, returning false, as soon as its weight exceeds the bound.
+        // Nothing is allocated by LEDA, thus trials can run concurrently.
+        // 
+        // If D is given the X_i's are kept in D, which must be initialized 
+        // with d rows and columns, and updated using the given threads.
+        template<class W>
+            bool DMCB_word_trial( dirsp<W,wptype>& SP, 
+                    int d, 
+                    wptype p, 
+                    std::vector< wspvecfp >& B,
+                    std::vector< wspvecfp >& X, 
+                    W& min,
+                    trial_bound<W>* bound, 
+                    matfp* D, 
+                    int threads )
+            { 
+                barrett F( p );
+
+                // initialize X_i's
+                indextype i,j;
+                B.assign( d, wspvecfp() );
+                X.assign( d, wspvecfp() );
+                for( i = 0; i < d; i++ ) { 
+                    if ( D != NULL ) 
+                        D->set( i, i, 1 );
+                    else
+                        X[i].push_back( std::make_pair( i, (wptype) 1 ) );
+                }
+
+                // now execute main loop
+                wspvecfp tmp, scratch;
+                std::vector< fpword > s( ( D != NULL ) ? d : 0 );
+                min = W(0);
+                for( i = 0; i < d; i++ ) { 
+
+                    // X_i is final
+                    if ( D != NULL ) 
+                        D->get_row( i, X[i] );
+
+                    // compute B_i
+                    min += SP.get_shortest_cycle( X[i], B[i] );
+                    if ( bound != NULL && bound->exceeded( min ) ) 
+                        return false;
+
+                    wptype inv = F.inverse( dot( X[i], B[i], F ) );
+
+                    if ( D != NULL ) { 
+                        // s = X_i / < X_i, B_i >
+                        D->scale_row( i, (fpword) inv, &s[0] );
+
+                        // update rows X_j, j > i
+#ifdef _OPENMP
+                        // each thread updates a contiguous block of rows, 
+                        // rows are independent so the result equals the serial one
+                        // not worth it for less than 16K words
+                        int rows = d - i - 1;
+                        int T = ( (double) rows * d < 16384.0 ) ? 1 : threads;
+                        if ( T > 1 ) { 
+#pragma omp parallel num_threads(T)
+                            { 
+                                int t = omp_get_thread_num(), nt = omp_get_num_threads();
+                                int first = i + 1 + (int) ( (double) rows * t / nt );
+                                int last = i + 1 + (int) ( (double) rows * ( t + 1 ) / nt );
+                                D->update_rows( first, last, B[i], &s[0] );
+                            }
+                            continue;
+                        }
+#else
+                        (void) threads;
+#endif
+                        D->update_rows( i + 1, d, B[i], &s[0] );
+                        continue;
+                    }
+
+                    // tmp = X_i / < X_i, B_i >
+                    tmp = X[i];
+                    for( size_t k = 0; k < tmp.size(); ++k ) 
+                        tmp[k].second = F.mul( tmp[k].second, inv );
+
+                    // update sets X_j, j > i
+                    for( j = i+1; j < d; j++ ) { 
+                        wptype c = dot( B[i], X[j], F );
+                        if ( c != 0 ) 
+                            sub_multiple( X[j], c, tmp, F, scratch );
+                    }
+                }
+
+                return true;
+            }
+
+        // The algorithm of DMCB() for a prime which fits in a word. 
+        template<class W>
+            W DMCB_word( const graph& g, 
+                    const edge_array<W>& len,
+                    array< mcb::spvecfp >& mcb,
+                    array< mcb::spvecfp >& proof,
+                    const mcb::edge_num& enumb,
+                    const ptype& P, 
+                    bool dense, 
+                    int threads )
+            { 
+                int d = enumb.dim_cycle_space();
+                wptype p = (wptype) P.to_long();
+                threads = num_threads( threads );
+
+                // initialize shortest paths
+                dirsp<W,wptype> SP( g, len, p, enumb, threads );
+
+                // the dense support vectors
+                matfp D;
+                if ( dense ) 
+                    D.init( d, d, (fpword) p );
+
+                std::vector< wspvecfp > B, X;
+                W min;
+                DMCB_word_trial( SP, d, p, B, X, min, (trial_bound<W>*) NULL, 
+                        dense ? &D : (matfp*) NULL, threads );
+
+                for( int i = 0; i < d; i++ ) { 
+                    mcb[i] = to_spvecfp( B[i], P, p );
+                    proof[i] = to_spvecfp( X[i], P, p );
+                }
+                return min;
+            }
+
+        // Independent trials of DMCB() with different primes which fit in a 
+        // word. With at least as many trials as threads the trials run 
+        // concurrently, each one on a single thread, otherwise they run one 
+        // after the other with all the threads. Dense trials always run one 
+        // after the other, so that a single d x d matrix is alive at any 
+        // time, and use all the threads for the row updates. Trials which 
+        // become heavier than a finished one are abandoned. The result is 
+        // the first trial with minimum weight, independently of the thread 
+        // scheduling.
+        template<class W>
+            W DMCB_word_trials( const graph& g, 
+                    const edge_array<W>& len,
+                    array< mcb::spvecfp >& mcb,
+                    array< mcb::spvecfp >& proof,
+                    const mcb::edge_num& enumb,
+                    const std::vector< ptype >& P, 
+                    bool dense, 
+                    int threads )
+            { 
+                int d = enumb.dim_cycle_space();
+                int times = (int) P.size();
+                threads = num_threads( threads );
+                int T = ( ! dense && times >= threads ) ? threads : 1;
+
+                std::vector< wptype > p( times );
+                for( int k = 0; k < times; ++k ) 
+                    p[k] = (wptype) P[k].to_long();
+
+                // one shortest path structure and workspace per concurrent trial
+                std::vector< count_ptr< dirsp<W,wptype> > > SP;
+                for( int t = 0; t < T; ++t ) 
+                    SP.push_back( count_ptr< dirsp<W,wptype> >( 
+                                new dirsp<W,wptype>( g, len, p[0], enumb, ( T > 1 ) ? 1 : threads ) ) );
+                std::vector< std::vector< wspvecfp > > B( T ), X( T ), bestB( T ), bestX( T );
+                std::vector< matfp > D( T );
+                std::vector< W > best( T, W(0) );
+                std::vector< int > besttrial( T, -1 );
+                trial_bound<W> bound;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(T) schedule(dynamic,1) if(T > 1)
+#endif
+                for( int k = 0; k < times; ++k ) { 
+                    int t = thread_num();
+                    SP[t]->reinit( p[k] );
+
+                    // the dense support vectors, if requested and p is small enough
+                    bool dk = dense && matfp::fits( p[k] );
+                    if ( dk ) 
+                        D[t].init( d, d, (fpword) p[k] );
+
+                    W min;
+                    if ( ! DMCB_word_trial( *SP[t], d, p[k], B[t], X[t], min, &bound, 
+                                dk ? &D[t] : (matfp*) NULL, ( T > 1 ) ? 1 : threads ) ) 
+                        continue;
+                    bound.update( min );
+
+                    // each thread gets its trials in increasing order
+                    if ( besttrial[t] < 0 || min < best[t] ) { 
+                        best[t] = min;
+                        besttrial[t] = k;
+                        bestB[t].swap( B[t] );
+                        bestX[t].swap( X[t] );
+                    }
+                }
+
+                // the first trial with minimum weight
+                int b = -1;
+                for( int t = 0; t < T; ++t ) { 
+                    if ( besttrial[t] < 0 ) continue;
+                    if ( b < 0 || best[t] < best[b] || 
+                            ( ! ( best[b] < best[t] ) && besttrial[t] < besttrial[b] ) ) 
+                        b = t;
+                }
+
+                for( int i = 0; i < d; i++ ) { 
+                    mcb[i] = to_spvecfp( bestB[b][i], P[ besttrial[b] ], p[ besttrial[b] ] );
+                    proof[i] = to_spvecfp( bestX[b][i], P[ besttrial[b] ], p[ besttrial[b] ] );
+                }
+                return best[b];
+            }
+
+    } // namespace detail end
+#endif
+
     /*! \name Directed Minimum Cycle Basis
     */
 
@@ -130,6 +441,16 @@ namespace mcb {
      * 
      *  The returned cycle basis might not be a minimum cycle basis.
      *  
+     *  If \f$p\f$ fits in a machine word, the arithmetic modulo \f$p\f$ uses 64-bit 
+     *  words with Barrett reduction instead of leda::integer. The entries of the 
+     *  proof are then returned in \f$(-p/2,p/2]\f$.
+     *  
+     *  The shortest cycle of each phase is found by one search from each vertex, 
+     *  these searches are distributed among the threads. With leda::integer 
+     *  arithmetic this requires LEDA with multithreading support (LEDA_MULTI_THREAD),
+     *  otherwise a single thread is used. The result does not depend on the number
+     *  of threads.
+     *  
      *  The function returns the weight of the cycle basis or is undefined
      *  if there were any errors. 
      *
@@ -141,6 +462,10 @@ namespace mcb {
      *  \param proof A leda::array of spvecfp to return the proof.
      *  \param enumb An edge numbering.
      *  \param p A leda::integer prime number.
+     *  \param support The representation of the support vectors, see mcb::support_type. 
+     *                 Dense support vectors are used only if \f$p < 2^{32}\f$.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \pre g is simple and loop-free
      *  \pre len is positive
      *  \pre enumb is already initialized with g
@@ -153,7 +478,9 @@ namespace mcb {
                 array< mcb::spvecfp >& mcb,
                 array< mcb::spvecfp >& proof,
                 const mcb::edge_num& enumb,
-                ptype& p
+                ptype& p, 
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
               )
         { 
 #if ! defined(LEDA_CHECKING_OFF)
@@ -168,7 +495,12 @@ namespace mcb {
                     error_handler(999,"MIN_CYCLE_BASIS: illegal edge (non-positive weight)");
             }
 
+#ifdef MCB_LEP_WORD_PRIMES
+            if ( detail::fits_word( p, g.number_of_nodes() ) ? 
+                    ! detail::is_prime( (wptype) p.to_long() ) : ! primes<ptype>::is_prime( p ) ) 
+#else
             if ( ! primes<ptype>::is_prime( p ) ) 
+#endif
                 error_handler(999,"DMCB: p is not a prime number!");
 
 #endif
@@ -180,8 +512,21 @@ namespace mcb {
             proof.resize( d );
             array< spvecfp >& X = proof;
 
-            // initialize shortest paths
+#ifdef MCB_LEP_WORD_PRIMES
+            // use word arithmetic whenever p fits
+            if ( detail::fits_word( p, g.number_of_nodes() ) ) 
+                return detail::DMCB_word( g, len, mcb, proof, enumb, p, 
+                        support == DENSE_SUPPORT && detail::matfp::fits( (wptype) p.to_long() ), 
+                        threads );
+#endif
+
+            // initialize shortest paths, leda::integer arithmetic is not 
+            // thread safe unless LEDA is
+#ifdef LEDA_MULTI_THREAD
+            dirsp<W,ptype> SP( g, len, p, enumb, threads );
+#else
             dirsp<W,ptype> SP( g, len, p, enumb );
+#endif
 
 #if  defined(LEP_DEBUG_OUTPUT)
             std::cout << "executing with prime p = " << p << std::endl;
@@ -243,7 +588,12 @@ namespace mcb {
      * 
      *  Since the algorithm is a randomized Monte-Carlo algorithm, the error argument 
      *  which should be less that 1 represents the acceptable error probability that the
-     *  returned cycle basis is not a minimum cycle basis.
+     *  returned cycle basis is not a minimum cycle basis. This is achieved by independent 
+     *  trials with different random primes. When all primes fit in a machine word and 
+     *  there are at least as many trials as threads, the trials with sparse support vectors 
+     *  run concurrently; dense trials run one after the other. A trial 
+     *  is abandoned as soon as it becomes heavier than a finished one. The result does 
+     *  not depend on the number of threads.
      *  
      *  The function returns the weight of the Minimum Cycle Basis or is undefined
      *  if there were any errors. 
@@ -256,6 +606,10 @@ namespace mcb {
      *  \param proof A leda::array of spvecfp to return the proof.
      *  \param enumb An edge numbering.
      *  \param error The error probability.
+     *  \param support The representation of the support vectors, see mcb::support_type. 
+     *                 Dense support vectors are used only if the primes are less than \f$2^{32}\f$.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \pre g is simple and loop-free
      *  \pre len is positive
      *  \pre enumb is already initialized with g
@@ -268,7 +622,9 @@ namespace mcb {
                 array< mcb::spvecfp >& mcb,
                 array< mcb::spvecfp >& proof,
                 const mcb::edge_num& enumb,
-                double error = 0.375
+                double error = 0.375, 
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
               )
         { 
 #if ! defined(LEDA_CHECKING_OFF)
@@ -300,16 +656,9 @@ namespace mcb {
             std::cout << error << std::endl;
 #endif
 
-            // create X and B matrices
-            array< spvecfp > X ( d );
-            array< spvecfp > B ( d );
-            W min_so_far = W(0);
-            bool min_so_far_inf = true;
-
-            // loop necessary times, for error probability to be correct
+            // pick the random primes
+            std::vector< ptype > P;
             while( times-- > 0 ) { 
-
-                // pick random prime
                 ptype p;
                 {
                     int logd = log( integer( d + 1 ) );
@@ -332,6 +681,12 @@ namespace mcb {
                         //std::cout << "testing p = " << p << std::endl;
 
                         // if is > 1 and prime break
+#ifdef MCB_LEP_WORD_PRIMES
+                        if ( p > 1 && detail::fits_word( p, g.number_of_nodes() ) ) { 
+                            if ( detail::is_prime( (wptype) p.to_long() ) ) break;
+                        }
+                        else
+#endif
                         if ( p > 1 && primes<ptype>::is_prime( p ) ) break;
                     }
                 }
@@ -339,8 +694,29 @@ namespace mcb {
 #if  defined(LEP_DEBUG_OUTPUT)
                 std::cout << "executing with prime p = " << p << std::endl;
 #endif
+                P.push_back( p );
+            }
+
+#ifdef MCB_LEP_WORD_PRIMES
+            // run the trials concurrently whenever all primes fit in a word
+            bool words = true;
+            for( size_t k = 0; k < P.size(); ++k ) 
+                words = words && detail::fits_word( P[k], g.number_of_nodes() );
+            if ( words ) 
+                return detail::DMCB_word_trials( g, len, mcb, proof, enumb, P, 
+                        support == DENSE_SUPPORT, threads );
+#endif
+
+            // create X and B matrices
+            array< spvecfp > X ( d );
+            array< spvecfp > B ( d );
+            W min_so_far = W(0);
+            bool min_so_far_inf = true;
+
+            // loop necessary times, for error probability to be correct
+            for( size_t k = 0; k < P.size(); ++k ) { 
 
-                W min = DMCB( g, len, B, X, enumb, p );
+                W min = DMCB( g, len, B, X, enumb, P[k], support, threads );
 
                 // if found better, update
                 if ( ( min_so_far_inf == true ) || 
@@ -382,6 +758,10 @@ namespace mcb {
      *  \param mcb A leda::array of spvecfp to return the MCB.
      *  \param enumb An edge numbering.
      *  \param error The error probability.
+     *  \param support The representation of the support vectors, see mcb::support_type. 
+     *                 Dense support vectors are used only if the primes are less than \f$2^{32}\f$.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \pre g is simple and loop-free
      *  \pre len is positive
      *  \pre enumb is already initialized with g
@@ -393,11 +773,13 @@ namespace mcb {
                 const edge_array<W>& len,
                 array< mcb::spvecfp >& mcb,
                 const mcb::edge_num& enumb,
-                double error = 0.375
+                double error = 0.375, 
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
               )
         {
             array< spvecfp > proof_tmp;
-            return DMCB(g, len, mcb, proof_tmp, enumb, error ); 
+            return DMCB(g, len, mcb, proof_tmp, enumb, error, support, threads ); 
         }
 
     /*! \brief Compute a minimum cycle basis of a weighted directed graph.
@@ -423,6 +805,10 @@ namespace mcb {
      *  \param mcb A leda::array of leda::arrays of ints to return the MCB.
      *  \param enumb An edge numbering.
      *  \param error The error probability.
+     *  \param support The representation of the support vectors, see mcb::support_type. 
+     *                 Dense support vectors are used only if the primes are less than \f$2^{32}\f$.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \pre g is simple and loop-free
      *  \pre len is positive
      *  \pre enumb is already initialized with g
@@ -434,7 +820,9 @@ namespace mcb {
                 const edge_array<W>& len,
                 array< array<etype> >& mcb,
                 const mcb::edge_num& enumb,
-                double error = 0.375
+                double error = 0.375, 
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
               )
         {
             array< spvecfp > mcb_tmp;
@@ -444,7 +832,7 @@ namespace mcb {
 
             // run the general version
             W min = DMCB<W>( g, len, mcb_tmp, \
-                    proof_tmp, enumb, error );
+                    proof_tmp, enumb, error, support, threads );
 
             // get p used
             ptype p = proof_tmp[0].pvalue(); 
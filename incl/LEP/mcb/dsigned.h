@@ -45,7 +45,6 @@
 #include <LEDA/graph/edge_array.h>
 #include <LEDA/core/array.h>
 #include <LEDA/core/list.h>
-#include <LEDA/core/p_queue.h>
 #include <LEDA/core/random_source.h>
 #include <LEDA/core/sortseq.h>
 #include <LEDA/core/tuple.h>
@@ -56,7 +55,6 @@
 #include <LEDA/edge_array.h>
 #include <LEDA/list.h>
 #include <LEDA/integer.h>
-#include <LEDA/p_queue.h>
 #include <LEDA/random_source.h>
 #include <LEDA/sortseq.h>
 #include <LEDA/tuple.h>
@@ -66,6 +64,12 @@
 #include <LEP/mcb/fp.h>
 #include <LEP/mcb/spvecfp.h>
 #include <LEP/mcb/arithm.h>
+#include <LEP/mcb/heap.h>
+#include <LEP/mcb/count_ptr.h>
+#include <LEP/mcb/threads.h>
+
+#include <vector>
+#include <utility>
 
 namespace mcb { 
 
@@ -77,55 +81,168 @@ namespace mcb {
     using leda::node_array;
     using leda::array;
     using leda::list;
-    using leda::node_list;
     using leda::integer;
     using leda::random_source;
-    using leda::p_queue;
-    using leda::pq_item;
     using leda::sortseq;
     using leda::seq_item;
-    using leda::three_tuple;
-    using leda::four_tuple;
 #endif
 
 
-    // defines for SSitem
-#define mcb_revi() first()
-#define mcb_dist() second()
-#define mcb_num_edges() third()
-#define mcb_pred() fourth()
+    namespace detail { 
+
+        /*! The index of the search states of a level graph, by their key 
+         *  \f$level \cdot n + node\f$. In general the keys are kept in a 
+         *  sorted sequence.
+         */
+        template<class PT>
+            class level_index 
+            { 
+                public:
+                    level_index() : S( mcb::compare ) {}
+
+                    void init( const PT&, int ) {}
 
-    // defines for preditem
-#define mcb_edge() first()
-#define mcb_other_node_index() second()
-#define mcb_other_node() third()
+                    int lookup( const PT& key ) const { 
+                        seq_item it = S.lookup( key );
+                        return ( it == nil ) ? -1 : S[ it ];
+                    }
+
+                    void insert( const PT& key, int state ) { 
+                        S.insert( key, state );
+                    }
 
+                    void clear() { 
+                        S.clear();
+                    }
+
+                private:
+                    sortseq< PT, int > S;
+            };
+
+#ifdef MCB_LEP_WORD_PRIMES
+        /*! The index of the search states for word keys. A flat array when 
+         *  there are few keys, otherwise a hash table with open addressing. 
+         *  Clearing takes time proportional to the number of inserted keys.
+         */
+        template<>
+            class level_index<wptype> 
+            { 
+                public:
+                    level_index() : flat( false ), shift( 0 ) {}
+
+                    void init( wptype keys, int states ) { 
+                        used.clear();
+                        used.reserve( states );
+                        flat = ( keys <= ( 1 << 20 ) );
+                        if ( flat ) { 
+                            key.clear();
+                            value.assign( (size_t) keys, -1 );
+                        }
+                        else { 
+                            size_t size = 1;
+                            shift = 64;
+                            while( size < 2 * (size_t) states ) { size <<= 1; --shift; }
+                            key.assign( size, -1 );
+                            value.assign( size, -1 );
+                        }
+                    }
+
+                    int lookup( wptype k ) const { 
+                        if ( flat ) 
+                            return value[ (size_t) k ];
+                        for( size_t s = slot( k ); key[s] != -1; s = ( s + 1 ) & ( key.size() - 1 ) ) 
+                            if ( key[s] == k ) 
+                                return value[s];
+                        return -1;
+                    }
+
+                    void insert( wptype k, int state ) { 
+                        size_t s = (size_t) k;
+                        if ( ! flat ) { 
+                            for( s = slot( k ); key[s] != -1; s = ( s + 1 ) & ( key.size() - 1 ) ) 
+                                ;
+                            key[s] = k;
+                        }
+                        value[s] = state;
+                        used.push_back( s );
+                    }
+
+                    void clear() { 
+                        for( size_t i = 0; i < used.size(); ++i ) { 
+                            value[ used[i] ] = -1;
+                            if ( ! flat ) 
+                                key[ used[i] ] = -1;
+                        }
+                        used.clear();
+                    }
+
+                private:
+                    size_t slot( wptype k ) const { 
+                        __extension__ typedef unsigned long long word;
+                        if ( shift >= 64 ) return 0;
+                        return (size_t) ( ( (word) k * 0x9E3779B97F4A7C15ULL ) >> shift );
+                    }
+
+                    bool flat;
+                    int shift;
+                    std::vector<wptype> key;
+                    std::vector<int> value;
+                    std::vector<size_t> used;   // slots in use
+            };
+#endif
+
+    } // namespace detail end
 
     // T = weight
     // PT = type of prime p
     template<class T, class PT> 
         class dirsp { 
 
-            typedef three_tuple< edge, PT, node > preditem;
-            typedef four_tuple< pq_item, T, indextype, preditem > SSitem;
-            typedef two_tuple< node, PT > pnode;
+            // a node of the level graph reached by the search
+            struct state 
+            { 
+                node v;
+                PT level;
+                T dist;
+                indextype num_edges;
+                edge pred_edge;     // edge of g to the predecessor, nil for the source
+                int pred;           // state of the predecessor
+
+                state( node v_, const PT& l, const T& d, int pr ) 
+                    : v(v_), level(l), dist(d), num_edges(0), pred_edge(nil), pred(pr) {}
+            };
+
+            // the data structures of the searches of one thread
+            struct search 
+            { 
+                // the search states of the level graph, in order of creation,
+                // indexed by their key level*n + node id
+                std::vector< state > states;
+                detail::level_index< PT > SS;
+                detail::binary_heap< T > PQ;        // priority queue on the states
+
+                std::vector< int > marked;           // times each node id was scanned
+                std::vector< int > marked_touched;   // touched marked node ids
+
+                // the cycle found, as (edge index, direction) pairs
+                std::vector< std::pair< indextype, etype > > path;
+            };
 
             public:
 
 
             // constructor
             dirsp( const graph& g, const edge_array<T>& length , 
-                    const PT& pin, const edge_num& en ) : 
+                    const PT& pin, const edge_num& en, int threads_ = 1 ) : 
                 n(g.number_of_nodes()), 
                 m(g.number_of_edges()), 
                 p( pin ), 
                 G( g ),
                 len ( length ),
                 enumb( en ),
-                SS( mcb::compare ),
+                threads( detail::num_threads( threads_ ) ),
                 cycle ( m ),
                 nodeid( g ), 
-                marked( g, 0 ),
                 Xe( g )
             {   
                 // give a numbering to the nodes
@@ -133,8 +250,23 @@ namespace mcb {
                 node v;
                 forall_nodes( v, g ) { 
                     nodeid[ v ] = i;
+                    nodes.push_back( v );
                     i++;
                 }
+
+                // each node is scanned at most twice, thus there are at most 
+                // 4m+1 search states
+                max_states = 4 * m + 1;
+
+                // one search per thread
+                for( int t = 0; t < threads; ++t ) { 
+                    searches.push_back( count_ptr< search >( new search() ) );
+                    search& sr = *searches[t];
+                    sr.states.reserve( max_states );
+                    sr.PQ.init( max_states );
+                    sr.SS.init( p * n, max_states );
+                    sr.marked.assign( n, 0 );
+                }
             }
 
             // reinitialize with different p
@@ -142,6 +274,8 @@ namespace mcb {
             // in order to reduce error probability
             void reinit( const PT& pin ) { 
                 p = pin;
+                for( size_t t = 0; t < searches.size(); ++t ) 
+                    searches[t]->SS.init( p * n, max_states );
             }
 
             // destructor
@@ -169,6 +303,30 @@ namespace mcb {
                 return ret;
             }
 
+            // compute shortest cycle, with the vectors as (index,value) pairs 
+            // sorted by index and the values of the cycle in [0,p)
+            T get_shortest_cycle( const std::vector< std::pair<indextype,PT> >& X, 
+                                  std::vector< std::pair<indextype,PT> >& C ) { 
+
+                // create X, on edge index
+                edge e;
+                forall_edges( e, G ) 
+                    Xe[ e ] = 0;
+                for( size_t k = 0; k < X.size(); ++k ) 
+                    Xe[ enumb( X[k].first ) ] = X[k].second;
+
+                // run shortest paths
+                T weight = run_shortest_paths();
+
+                C.clear();
+                for( indextype i = 0; i < m; i++ ) { 
+                    if ( cycle[ i ] != 0 ) { 
+                        C.push_back( std::make_pair( i, ( cycle[i] > 0 ) ? PT( cycle[i] ) : p + PT( cycle[i] ) ) );
+                    }
+                }
+                return weight;
+            }
+
             private:
 
             // get X on edge index, by spvecfp
@@ -185,187 +343,222 @@ namespace mcb {
             }
 
 
-            // record a cycle, by traversing pred array
-            void record_cycle( const PT& t, array< etype >& cyc ) { 
-                cyc.init( 0 );
+            // record a cycle, by traversing the predecessors of a state
+            void record_cycle( search& sr, int s ) { 
+                sr.path.clear();
 
-                PT cur = t;
-                seq_item sicur = SS.lookup( cur );
                 node u;
                 edge e;
-                while( SS[ sicur ].mcb_pred().mcb_edge() != nil ) { 
+                while( sr.states[ s ].pred_edge != nil ) { 
 
-                    u = SS[ sicur ].mcb_pred().mcb_other_node();
-                    e = SS[ sicur ].mcb_pred().mcb_edge();
+                    u = sr.states[ sr.states[ s ].pred ].v;
+                    e = sr.states[ s ].pred_edge;
                     if ( u == G.target( e ) ) { // give + direction
-                        cyc[ enumb( e ) ] = 1;
+                        sr.path.push_back( std::make_pair( enumb( e ), (etype) 1 ) );
                     }
                     else { // give - direction
-                        cyc[ enumb( e ) ] = -1;
+                        sr.path.push_back( std::make_pair( enumb( e ), (etype) -1 ) );
                     }
 
-                    cur = SS[ sicur ].mcb_pred().mcb_other_node_index();
-                    sicur = SS.lookup( cur );
+                    s = sr.states[ s ].pred;
                 }
             }
 
 
-            // get the index of a node in the reverse index of the PQ
+            // get the index of a node in the level graph
             inline PT get_revi_index( const node& v, const PT& level ) { 
                 return level * n + nodeid[ v ];
             }
 
+            // create a search state
+            int new_state( search& sr, node v, const PT& level, const T& dist, int pred ) { 
+                int s = (int) sr.states.size();
+                sr.states.push_back( state( v, level, dist, pred ) );
+                sr.SS.insert( get_revi_index( v, level ), s );
+                return s;
+            }
+
 
             // init used data structures
-            void init_used_dijkstra() { 
+            void init_used_dijkstra( search& sr ) { 
                 // init marked
-                while( marked_touched.empty() == false ) 
-                    marked[ marked_touched.pop() ] = 0;
+                for( size_t i = 0; i < sr.marked_touched.size(); ++i ) 
+                    sr.marked[ sr.marked_touched[i] ] = 0;
+                sr.marked_touched.clear();
 
                 // init all nodes reached by SP
-                SS.clear();
+                sr.SS.clear();
+                sr.states.clear();
 
                 // clear priority queue
-                PQ.clear();
+                sr.PQ.clear();
             }
 
 
-            // execute the shortest paths
-            T run_shortest_paths( ) { 
+            // Shortest path in the level graph from (v,0) to some (v,l) with 
+            // l != 0. The search stops as soon as the distances exceed the bound 
+            // M, but never prunes states with smaller distance. Thus the cycle 
+            // found, if any, does not depend on M. The cycle is left in sr.path.
+            bool search_from( search& sr, node v, const T& M, bool M_equals_infinity, 
+                    T& D, indextype& D_num_edges ) 
+            { 
+                bool found = false;
 
-                T minall = T(0);
-                indextype minall_num_edges = 0;
-                bool is_minall_inf = true;
+                // add source vertex to PQ
+                sr.PQ.insert( new_state( sr, v, 0, T(0), -1 ), T(0) );
 
+                // do shortest path
+                node u, w; // nodes
+                PT wl; // level
+                int su, sw; // search states
+                edge e;
+                while( sr.PQ.empty() == false ) { 
+                    // check if beyond the bound
+                    su = sr.PQ.find_min();
+                    if ( M_equals_infinity == false && M < sr.PQ.prio( su ) ) 
+                        break;
+
+                    // extract min
+                    sr.PQ.del_min();
+                    u = sr.states[ su ].v;
+
+                    // check if we are done
+                    if ( u == v && sr.states[ su ].level != 0 ) { 
+                        D = sr.states[ su ].dist;
+                        D_num_edges = sr.states[ su ].num_edges;
+                        record_cycle( sr, su );
+                        found = true;
+                        break;
+                    }
 
-                node v; 
-                forall_nodes( v, G ) { // do n shortest paths
 
-                    T min = T(0);
-                    indextype min_num_edges = 0;
-                    bool is_min_inf = true;
-
-                    // add source vertex to PQ
-                    PT vi = get_revi_index( v, 0 );
-                    SS.insert( vi , 
-                            SSitem( PQ.insert( T(0) , pnode( v, 0 ) ),
-                                T( 0 ),
-                                0,
-                                preditem( nil, 0 , nil )
-                                ) 
-                            );
-
-
-                    // do shortest path
-                    pq_item pqi;
-                    node u, w; // nodes
-                    PT ul, wl; // levels
-                    PT uindex, windex; // index on arrays
-                    seq_item siu, siw;
-                    edge e;
-                    while( PQ.empty() == false ) { 
-                        // extract min
-                        pqi = PQ.find_min(); 
-                        u = PQ[ pqi ].first(); // get vertex
-                        ul = PQ[ pqi ].second(); // get level
-                        PQ.del_item( pqi );
-
-                        // find index of u in level graph
-                        uindex = get_revi_index( u, ul );
-                        siu = SS.lookup( uindex );
-
-                        // check if we are done
-                        if ( u == v && ul != 0 ) { 
-                            min = SS[ siu ].mcb_dist();
-                            min_num_edges = SS[ siu ].mcb_num_edges();
-                            is_min_inf = false;
-                            break;
-                        }
+                    // check if vertex is too far
+                    int& mu = sr.marked[ nodeid[ u ] ];
+                    if ( mu >= 2 ) continue;
 
+                    // increment marked
+                    if ( ++mu == 1 ) sr.marked_touched.push_back( nodeid[ u ] );
 
-                        // check if vertex is too far
-                        if ( marked[ u ] >= 2 ) continue;
 
-                        // increment marked
-                        marked[ u ] = marked[ u ] + 1;
-                        if ( marked[ u ] == 1 ) marked_touched.append( u );
 
+                    // find neighbors
+                    PT ul = sr.states[ su ].level;
+                    T du = sr.states[ su ].dist;
+                    indextype nu = sr.states[ su ].num_edges;
+                    forall_inout_edges( e, u ) { 
 
+                        w = G.opposite( e, u );
 
-                        // find neighbors
-                        forall_inout_edges( e, u ) { 
+                        // find level of w
+                        if ( w == G.target( e ) ) {  // e = u -> w
+                            wl = ( ul + Xe[ e ] ) % p;
+                        }
+                        else { // e = w -> u
+                            wl = ( ul - Xe[ e ] ) % p;
+                        }
+                        while ( wl < 0 ) wl += p; // [-i]_p = [p-i]_p
 
-                            w = G.opposite( e, u );
 
-                            // find level of w
-                            if ( w == G.target( e ) ) {  // e = u -> w
-                                wl = ( ul + Xe[ e ] ) % p;
-                            }
-                            else { // e = w -> u
-                                wl = ( ul - Xe[ e ] ) % p;
-                            }
-                            while ( wl < 0 ) wl += p; // [-i]_p = [p-i]_p
-
-
-                            // find index in level graph
-                            windex = get_revi_index( w, wl );
-                            siw = SS.lookup( windex );
-
-                            // now update if necessary
-                            T c = SS[ siu ].mcb_dist() + len [ e ];
-                            if ( siw == nil ) { 
-                                // don't insert if more than current minimum
-                                if ( is_minall_inf == false && c > minall )
-                                    continue;
-                                // insert ( for now, with some info undetermined )
-                                siw = SS.insert( windex, 
-                                        SSitem( PQ.insert( c, pnode( w , wl ) ), 
-                                            c , 
-                                            0 , 
-                                            preditem( nil, 0, nil ) ) );   
-                            }
-                            else if ( c < SS[ siw ].mcb_dist() ) { 
-                                PQ.decrease_p( SS[ siw ].mcb_revi() , c );
-                            }
-                            else continue;
-
-                            // record changes
-                            SS[ siw ].mcb_dist() = c;
-                            SS[ siw ].mcb_num_edges() = SS[ siu ].mcb_num_edges() + 1;
-                            SS[ siw ].mcb_pred().mcb_edge() = e;
-                            SS[ siw ].mcb_pred().mcb_other_node_index() = uindex;
-                            SS[ siw ].mcb_pred().mcb_other_node() = u;
+                        // find state in level graph
+                        sw = sr.SS.lookup( get_revi_index( w, wl ) );
+
+                        // now update if necessary
+                        T c = du + len [ e ];
+                        if ( sw < 0 ) { 
+                            sw = new_state( sr, w, wl, c, su );
+                            sr.PQ.insert( sw, c );
+                        }
+                        else if ( c < sr.states[ sw ].dist ) { 
+                            sr.PQ.decrease_p( sw, c );
                         }
+                        else continue;
 
+                        // record changes
+                        sr.states[ sw ].dist = c;
+                        sr.states[ sw ].num_edges = nu + 1;
+                        sr.states[ sw ].pred_edge = e;
+                        sr.states[ sw ].pred = su;
                     }
 
+                }
 
+                // init touched data
+                init_used_dijkstra( sr );
+
+                return found;
+            }
 
-                    // possible record path
-                    if ( is_min_inf == false ) {
-                        if ( ( is_minall_inf == true ) ||
-                                ( min < minall ) || 
-                                ( ( min == minall ) && ( min_num_edges < minall_num_edges ) ) 
-                           ) { 
-                            // record new path as better either if it has less weight
-                            // or if the weight is equal and it has less number of edges
 
-                            // record path to a cycle
-                            record_cycle( get_revi_index( u, ul ), cycle );
-                            minall = min;
-                            minall_num_edges = min_num_edges;
-                            is_minall_inf = false;
+            // execute the shortest paths, one from each node. The searches are 
+            // distributed among the threads and each one is bounded by the best 
+            // cycle found so far by any thread. A cycle is better if it has less 
+            // weight, or equal weight and less edges, or it is equal in both and 
+            // belongs to a node with smaller id. Thus the result does not depend 
+            // on the thread scheduling.
+            T run_shortest_paths( ) { 
+
+                T minall = T(0);
+                indextype minall_num_edges = 0;
+                bool is_minall_inf = true;
+                int minall_vertex = -1;
+                std::vector< std::pair< indextype, etype > > minall_path;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) if(threads > 1)
+#endif
+                { 
+                    search& sr = *searches[ detail::thread_num() ];
+                    T min = T(0), lM = T(0);
+                    indextype min_num_edges = 0;
+                    bool lM_equals_infinity = true;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+                    for( int i = 0; i < n; ++i ) { // do n shortest paths
+#ifdef _OPENMP
+#pragma omp critical(mcb_dirsp_bound)
+#endif
+                        { 
+                            lM = minall;
+                            lM_equals_infinity = is_minall_inf;
                         }
-                    }
 
-                    // init touched data
-                    init_used_dijkstra();
+                        if ( ! search_from( sr, nodes[ i ], lM, lM_equals_infinity, 
+                                    min, min_num_edges ) ) 
+                            continue;
+
+#ifdef _OPENMP
+#pragma omp critical(mcb_dirsp_bound)
+#endif
+                        { 
+                            if ( ( is_minall_inf == true ) ||
+                                    ( min < minall ) || 
+                                    ( ! ( minall < min ) && ( min_num_edges < minall_num_edges || 
+                                      ( min_num_edges == minall_num_edges && i < minall_vertex ) ) ) 
+                               ) { 
+                                // record new path as better either if it has less weight
+                                // or if the weight is equal and it has less number of edges
+                                // or if both are equal and its node comes first
+                                minall = min;
+                                minall_num_edges = min_num_edges;
+                                minall_vertex = i;
+                                minall_path = sr.path;
+                                is_minall_inf = false;
+                            }
+                        }
+                    }
                 }
 
                 // now return path found
                 if ( is_minall_inf == true ) 
                     leda::error_handler(999,"MIN_CYCLE_BASIS: no cycle found :(");
 
+                // record path to a cycle
+                cycle.init( 0 );
+                for( size_t k = 0; k < minall_path.size(); ++k ) 
+                    cycle[ minall_path[k].first ] = minall_path[k].second;
+
                 return minall;
             }
 
@@ -377,42 +570,18 @@ namespace mcb {
             const graph& G;
             const edge_array< T > &len; // edge lengths
             const edge_num& enumb;      // edge numbering
-            p_queue<T,pnode> PQ;        // priority queue
-
-            // sortseq keys on node id of a node in levelg
-            // SSitem
-            // contains first()  = reverse index on priority queue, 
-            //                     node(in levelg) -> pq_item
-            //          second() = distance of shortest path in 
-            //                     levelg to this node
-            //          third()  = number of edges of shortest path in 
-            //                     levelg to this node
-            //          fourth() = predecessor as three_tuple in levelg 
-            //                     to this node
-            //                     preditem
-            //                     contains first()  = edge e of g
-            //                              second() = node id of other 
-            //                                         end in levelg
-            //                              third()  = node in g on other end
-            sortseq< PT, SSitem > SS;
+            int threads;
+
+            int max_states;
+            std::vector< count_ptr< search > > searches;  // one per thread
 
             array< etype > cycle;                // incident vector of cycles, indexed on 
             // numbering of edges (enumb(e))
-            node_array< PT > nodeid;             // nodes' ids   of g
-            node_array< unsigned short > marked; // marked nodes of g 
-            node_list marked_touched;            // touched marked nodes 
+            node_array< indextype > nodeid;      // nodes' ids   of g
+            std::vector< node > nodes;           // the nodes of g by id
             edge_array< PT > Xe;                 // help set to construct the cycle
         };
 
-    // now undefine, all defined stuff for SSitem and preditem
-#undef mcb_revi
-#undef mcb_dist
-#undef mcb_num_edges
-#undef mcb_pred
-#undef mcb_edge
-#undef mcb_other_node_index
-#undef mcb_other_node
-
     
 } // end of mcb namespace
 
@@ -0,0 +1,523 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+/*! \file heap.h
+ *  \brief Priority queues on integer items used by the shortest path computations.
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <climits>
+#include <LEP/mcb/config.h>
+
+namespace mcb
+{
+
+namespace detail
+{
+
+    /*! The position of the highest set bit of a non-zero word. */
+    inline int highest_bit( unsigned long x ) 
+    { 
+#if defined(__GNUC__)
+        return (int) ( sizeof( unsigned long ) * CHAR_BIT - 1 ) - __builtin_clzl( x );
+#else
+        int b = 0;
+        while( x >>= 1 ) 
+            ++b;
+        return b;
+#endif
+    }
+
+    /*! \brief An addressable binary heap on the items \f$0,\dots,n-1\f$.
+     *
+     *  Items with equal priorities are removed in increasing order of their index,
+     *  thus the behavior of the heap depends only on its contents and not on the 
+     *  order of the operations. This makes the shortest path trees computed with it
+     *  deterministic.
+     *
+     *  The heap keeps all its storage between uses, clear() takes time proportional 
+     *  to the number of items in the heap and no operation besides init() allocates 
+     *  memory. Different objects can be used concurrently by different threads.
+     */
+    template<typename W>
+    class binary_heap 
+    {
+        public:
+            binary_heap() {}
+
+            /*! Initialize an empty heap for the items \f$0,\dots,n-1\f$. */
+            void init( int n ) { 
+                h.clear();
+                h.reserve( n );
+                pos.assign( n, -1 );
+                key.assign( n, W() );
+            }
+
+            bool empty() const { return h.empty(); }
+
+            int size() const { return (int) h.size(); }
+
+            bool member( int i ) const { return pos[i] >= 0; }
+
+            const W& prio( int i ) const { return key[i]; }
+
+            int find_min() const { return h[0]; }
+
+            void insert( int i, const W& k ) { 
+                key[i] = k;
+                pos[i] = (int) h.size();
+                h.push_back( i );
+                sift_up( pos[i] );
+            }
+
+            void decrease_p( int i, const W& k ) { 
+                key[i] = k;
+                sift_up( pos[i] );
+            }
+
+            int del_min() { 
+                int i = h[0];
+                int last = h.back();
+                h.pop_back();
+                pos[i] = -1;
+                if ( ! h.empty() ) { 
+                    h[0] = last;
+                    pos[last] = 0;
+                    sift_down( 0 );
+                }
+                return i;
+            }
+
+            void clear() { 
+                for( size_t j = 0; j < h.size(); ++j ) 
+                    pos[ h[j] ] = -1;
+                h.clear();
+            }
+
+        private:
+
+            bool less( int a, int b ) const { 
+                if ( key[a] < key[b] ) return true;
+                if ( key[b] < key[a] ) return false;
+                return a < b;
+            }
+
+            void sift_up( int p ) { 
+                int i = h[p];
+                while( p > 0 ) { 
+                    int q = ( p - 1 ) / 2;
+                    if ( ! less( i, h[q] ) ) break;
+                    h[p] = h[q];
+                    pos[ h[p] ] = p;
+                    p = q;
+                }
+                h[p] = i;
+                pos[i] = p;
+            }
+
+            void sift_down( int p ) { 
+                int i = h[p];
+                int n = (int) h.size();
+                while( true ) { 
+                    int c = 2 * p + 1;
+                    if ( c >= n ) break;
+                    if ( c + 1 < n && less( h[c+1], h[c] ) ) ++c;
+                    if ( ! less( h[c], i ) ) break;
+                    h[p] = h[c];
+                    pos[ h[p] ] = p;
+                    p = c;
+                }
+                h[p] = i;
+                pos[i] = p;
+            }
+
+            std::vector<int> h;     // the heap
+            std::vector<int> pos;   // position of each item in the heap, -1 if absent
+            std::vector<W> key;     // priorities
+    };
+
+    /*! \brief Doubly linked lists of items, one for each bucket. 
+     *
+     *  Common part of the bucket based heaps. The lists are stored in arrays 
+     *  indexed by the items, so linking and unlinking never allocates memory. 
+     *  The items inserted since the last reset are recorded in a stack, thus 
+     *  resetting takes time proportional to their number and not to the number 
+     *  of items or buckets.
+     *
+     *  The items whose priority equals the current minimum are kept apart, in 
+     *  a binary heap on their index, so that they are removed in increasing 
+     *  order of their index as in binary_heap.
+     */
+    class bucket_lists
+    {
+        protected:
+            enum { tied = INT_MAX };   // bucket of the items with the minimum priority
+
+            void init_lists( int n, int b ) { 
+                head.assign( b, -1 );
+                next.assign( n, -1 );
+                prev.assign( n, -1 );
+                bucket.assign( n, -1 );
+                used.clear();
+                used.reserve( n );
+                ties.clear();
+                ties.reserve( n );
+                count = 0;
+            }
+
+            void link_tie( int i ) { 
+                bucket[i] = tied;
+                ties.push_back( i );
+                std::push_heap( ties.begin(), ties.end(), std::greater<int>() );
+            }
+
+            int pop_tie() { 
+                std::pop_heap( ties.begin(), ties.end(), std::greater<int>() );
+                int i = ties.back();
+                ties.pop_back();
+                bucket[i] = -1;
+                return i;
+            }
+
+            // move all the items of a bucket to the tied items
+            void tie_bucket( int b ) { 
+                int i = head[b];
+                head[b] = -1;
+                while( i >= 0 ) { 
+                    int nx = next[i];
+                    link_tie( i );
+                    i = nx;
+                }
+            }
+
+            void link( int i, int b ) { 
+                bucket[i] = b;
+                prev[i] = -1;
+                next[i] = head[b];
+                if ( head[b] >= 0 ) 
+                    prev[ head[b] ] = i;
+                head[b] = i;
+            }
+
+            void unlink( int i ) { 
+                int b = bucket[i];
+                if ( prev[i] >= 0 ) 
+                    next[ prev[i] ] = next[i];
+                else
+                    head[b] = next[i];
+                if ( next[i] >= 0 ) 
+                    prev[ next[i] ] = prev[i];
+                bucket[i] = -1;
+            }
+
+            void reset_lists() { 
+                for( size_t j = 0; j < used.size(); ++j ) { 
+                    int i = used[j];
+                    if ( bucket[i] >= 0 ) { 
+                        if ( bucket[i] != tied ) 
+                            head[ bucket[i] ] = -1;
+                        bucket[i] = -1;
+                    }
+                }
+                used.clear();
+                ties.clear();
+                count = 0;
+            }
+
+            std::vector<int> head;      // first item of each bucket
+            std::vector<int> next;      // next item in the same bucket
+            std::vector<int> prev;      // previous item in the same bucket
+            std::vector<int> bucket;    // bucket of each item, -1 if absent
+            std::vector<int> used;      // items inserted since the last reset
+            std::vector<int> ties;      // heap of the items with the minimum priority
+            int count;                  // number of items
+    };
+
+    /*! \brief A monotone radix heap on the items \f$0,\dots,n-1\f$ with non-negative 
+     *         integer priorities.
+     *
+     *  Item \f$i\f$ is kept in bucket \f$b\f$ where \f$b-1\f$ is the highest bit in which its 
+     *  priority differs from the last removed minimum. Removing the minimum redistributes 
+     *  a single bucket, all operations take amortized \f$O(\log C)\f$ time where \f$C\f$ 
+     *  is the largest priority. 
+     *
+     *  The heap is monotone, an item must not be inserted or decreased to a priority less 
+     *  than the last removed minimum. This is always the case in dijkstra's algorithm with 
+     *  non-negative edge lengths. The type W must be convertible to unsigned long.
+     *
+     *  It provides the same interface as binary_heap and removes items with equal 
+     *  priorities in increasing order of their index.
+     */
+    template<typename W>
+    class radix_heap : private bucket_lists
+    {
+        public:
+            radix_heap() {}
+
+            /*! Initialize an empty heap for the items \f$0,\dots,n-1\f$. */
+            void init( int n ) { 
+                init_lists( n, nbuckets );
+                key.assign( n, W() );
+                last = 0;
+            }
+
+            bool empty() const { return count == 0; }
+
+            int size() const { return count; }
+
+            bool member( int i ) const { return bucket[i] >= 0; }
+
+            const W& prio( int i ) const { return key[i]; }
+
+            int find_min() { 
+                if ( ties.empty() ) 
+                    redistribute();
+                return ties.front();
+            }
+
+            void insert( int i, const W& k ) { 
+                key[i] = k;
+                place( i, slot( k ) );
+                used.push_back( i );
+                ++count;
+            }
+
+            void decrease_p( int i, const W& k ) { 
+                key[i] = k;
+                int b = slot( k );
+                if ( b != bucket[i] && bucket[i] != tied ) { 
+                    unlink( i );
+                    place( i, b );
+                }
+            }
+
+            int del_min() { 
+                find_min();
+                --count;
+                return pop_tie();
+            }
+
+            void clear() { 
+                reset_lists();
+                last = 0;
+            }
+
+        private:
+            enum { nbuckets = sizeof( unsigned long ) * CHAR_BIT + 1 };
+
+            int slot( const W& k ) const { 
+                unsigned long x = (unsigned long) k ^ last;
+                return ( x == 0 ) ? 0 : highest_bit( x ) + 1;
+            }
+
+            // bucket 0 holds the items equal to the last minimum, these are tied
+            void place( int i, int b ) { 
+                if ( b == 0 ) 
+                    link_tie( i );
+                else
+                    link( i, b );
+            }
+
+            // move the items of the first non-empty bucket to lower buckets,
+            // using their minimum as the new reference point
+            void redistribute() { 
+                int b = 1;
+                while( head[b] < 0 ) 
+                    ++b;
+                int i = head[b];
+                unsigned long min = (unsigned long) key[i];
+                for( i = next[i]; i >= 0; i = next[i] ) 
+                    if ( (unsigned long) key[i] < min ) 
+                        min = (unsigned long) key[i];
+                last = min;
+
+                i = head[b];
+                head[b] = -1;
+                while( i >= 0 ) { 
+                    int nx = next[i];
+                    place( i, slot( key[i] ) );
+                    i = nx;
+                }
+            }
+
+            std::vector<W> key;     // priorities
+            unsigned long last;     // last removed minimum
+    };
+
+    /*! \brief A bucket queue (Dial's implementation) on the items \f$0,\dots,n-1\f$ with 
+     *         non-negative integer priorities.
+     *
+     *  The buckets form a circular array indexed by the priorities. When used by dijkstra's 
+     *  algorithm with maximum edge length \f$C\f$ all priorities in the heap lie in 
+     *  \f$[d,d+C]\f$ where \f$d\f$ is the current minimum, so \f$C+1\f$ buckets suffice. The 
+     *  circular array is doubled whenever an insertion does not fit, thus \f$C\f$ need not 
+     *  be known in advance. Insertions and decreases take constant time, finding the 
+     *  minimum scans the empty buckets in between. Best suited for small integer lengths.
+     *
+     *  The heap is monotone and W must be convertible to unsigned long, see radix_heap.
+     *  It provides the same interface as binary_heap and removes items with equal 
+     *  priorities in increasing order of their index.
+     */
+    template<typename W>
+    class dial_heap : private bucket_lists
+    {
+        public:
+            dial_heap() {}
+
+            /*! Initialize an empty heap for the items \f$0,\dots,n-1\f$. */
+            void init( int n ) { 
+                init_lists( n, 16 );
+                mask = 15;
+                key.assign( n, W() );
+                cur = 0;
+            }
+
+            bool empty() const { return count == 0; }
+
+            int size() const { return count; }
+
+            bool member( int i ) const { return bucket[i] >= 0; }
+
+            const W& prio( int i ) const { return key[i]; }
+
+            // the items of priority cur are tied, all others are in the buckets
+            int find_min() { 
+                if ( ties.empty() ) { 
+                    while( head[ cur & mask ] < 0 ) 
+                        ++cur;
+                    tie_bucket( (int) ( cur & mask ) );
+                }
+                return ties.front();
+            }
+
+            void insert( int i, const W& k ) { 
+                if ( (unsigned long) k - cur > mask ) 
+                    grow( (unsigned long) k - cur );
+                key[i] = k;
+                place( i );
+                used.push_back( i );
+                ++count;
+            }
+
+            void decrease_p( int i, const W& k ) { 
+                if ( bucket[i] == tied ) 
+                    return;
+                key[i] = k;
+                unlink( i );
+                place( i );
+            }
+
+            int del_min() { 
+                find_min();
+                --count;
+                return pop_tie();
+            }
+
+            void clear() { 
+                reset_lists();
+                cur = 0;
+            }
+
+        private:
+
+            void place( int i ) { 
+                if ( (unsigned long) key[i] == cur ) 
+                    link_tie( i );
+                else
+                    link( i, (int) ( (unsigned long) key[i] & mask ) );
+            }
+
+            // enlarge the circular array so that it can hold the range [cur,cur+span]
+            void grow( unsigned long span ) { 
+                unsigned long b = mask + 1;
+                while( b <= span ) 
+                    b *= 2;
+                std::vector<int> old( b, -1 );
+                head.swap( old );
+                mask = b - 1;
+                for( size_t j = 0; j < old.size(); ++j ) { 
+                    int i = old[j];
+                    while( i >= 0 ) { 
+                        int nx = next[i];
+                        link( i, (int) ( (unsigned long) key[i] & mask ) );
+                        i = nx;
+                    }
+                }
+            }
+
+            std::vector<W> key;     // priorities
+            unsigned long mask;     // number of buckets minus one
+            unsigned long cur;      // lower bound on the minimum priority
+    };
+
+    /*! Whether W is a built-in integer type, whose values can be the priorities 
+     *  of radix_heap and dial_heap. 
+     */
+    template<typename W> struct integer_priorities { enum { value = false }; };
+    template<> struct integer_priorities<short> { enum { value = true }; };
+    template<> struct integer_priorities<unsigned short> { enum { value = true }; };
+    template<> struct integer_priorities<int> { enum { value = true }; };
+    template<> struct integer_priorities<unsigned int> { enum { value = true }; };
+    template<> struct integer_priorities<long> { enum { value = true }; };
+    template<> struct integer_priorities<unsigned long> { enum { value = true }; };
+
+    /*! \brief The heap used for a priority queue implementation parameter.
+     *
+     *  Our own heaps are used as they are, any other type, like the LEDA priority 
+     *  queue implementations leda::bin_heap or leda::f_heap which the searches 
+     *  accepted before, is mapped to binary_heap.
+     */
+    template<typename W, class prio_impl>
+    struct heap_selector { typedef binary_heap<W> type; };
+
+    template<typename W>
+    struct heap_selector< W, binary_heap<W> > { typedef binary_heap<W> type; };
+
+    template<typename W>
+    struct heap_selector< W, radix_heap<W> > { typedef radix_heap<W> type; };
+
+    template<typename W>
+    struct heap_selector< W, dial_heap<W> > { typedef dial_heap<W> type; };
+
+} // namespace detail end
+
+} // namespace mcb end
+
+#endif  // HEAP_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
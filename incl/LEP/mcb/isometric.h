@@ -0,0 +1,177 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+/*! \file isometric.h
+ *  \brief Filters for the candidate cycles of Horton's superset.
+ *
+ *  A cycle \f$C\f$ is isometric if for any two vertices \f$x,y\f$ of \f$C\f$ 
+ *  the shorter of the two paths of \f$C\f$ between \f$x\f$ and \f$y\f$ is a 
+ *  shortest path of the graph. A cycle which is not isometric is the sum of 
+ *  two strictly shorter cycles, thus it can never be the shortest cycle with 
+ *  odd intersection with a support vector. Both such cycles and copies of the 
+ *  same cycle, which are created from different roots, can be removed from 
+ *  the superset without changing the computed minimum cycle basis.
+ *
+ *  The filter can be disabled at compile time by defining 
+ *  MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER.
+ */
+
+#ifndef ISOMETRIC_H
+#define ISOMETRIC_H
+
+#include <LEP/mcb/config.h>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace mcb
+{
+
+namespace detail
+{
+
+    /*! A random key of an edge number. The XOR of the keys of the edges of 
+     *  a cycle identifies the cycle with high probability, independently of 
+     *  the order of its edges.
+     */
+    inline unsigned long cycle_key( int i ) 
+    { 
+        unsigned long x = (unsigned long) i * 0x9E3779B97F4A7C15UL + 0x632BE59BD9B4E019UL;
+        x ^= x >> 30; x *= 0xBF58476D1CE4E5B9UL;
+        x ^= x >> 27; x *= 0x94D049BB133111EBUL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /*! Check whether a simple cycle is isometric. 
+     *
+     *  For each vertex \f$x\f$ it suffices to check the two endpoints of the 
+     *  edge antipodal to \f$x\f$, since every other vertex lies on a shortest 
+     *  path of the cycle from \f$x\f$ to one of them. The antipodal edges are 
+     *  found with a pointer which moves forward, thus the running time is linear 
+     *  in the number of vertices plus the distance queries.
+     *
+     *  The test needs exact arithmetic and always succeeds if W is not exact.
+     *
+     *  \param v The vertices of the cycle in cyclic order.
+     *  \param l The lengths of the edges, l[i] is the length of (v[i],v[i+1]).
+     *  \param d The distances of the graph, d(x,y) for two vertices.
+     *  \return True if the cycle is isometric.
+     */
+    template<class W, class Dist>
+        bool is_isometric( const std::vector<int>& v, const std::vector<W>& l, const Dist& d ) 
+        { 
+            if ( ! std::numeric_limits<W>::is_exact ) 
+                return true;
+
+            int k = (int) v.size();
+
+            // prefix lengths over two rounds of the cycle
+            std::vector<W> P( 2 * k + 1 );
+            P[0] = W();
+            for( int i = 0; i < 2 * k; ++i ) 
+                P[i+1] = P[i] + l[ i % k ];
+            W T = P[k];
+
+            int j = 0;  // last offset with forward length at most T/2 
+            for( int i = 0; i < k; ++i ) { 
+                if ( j < i ) j = i;
+                while( j + 1 < i + k && ( P[j+1] - P[i] ) + ( P[j+1] - P[i] ) <= T ) 
+                    ++j;
+
+                if ( j > i && d( v[i], v[ j % k ] ) < P[j] - P[i] ) 
+                    return false;
+                if ( j + 1 < i + k && d( v[i], v[ (j+1) % k ] ) < T - ( P[j+1] - P[i] ) ) 
+                    return false;
+            }
+            return true;
+        }
+
+    /* Order of positions by key, then by position. */
+    struct key_order 
+    { 
+        const std::vector<unsigned long>& key;
+        key_order( const std::vector<unsigned long>& k ) : key(k) {}
+        bool operator()( size_t a, size_t b ) const { 
+            return key[a] < key[b] || ( key[a] == key[b] && a < b );
+        }
+    };
+
+    /*! Remove the copies of cycles from a vector of candidates, keeping the 
+     *  first occurrence of each cycle. The order of the remaining candidates 
+     *  is preserved. 
+     *
+     *  \param c The candidates.
+     *  \param key The XOR of the edge keys of each candidate.
+     *  \param same A functor deciding whether two candidates have the same edges,
+     *              only called for candidates with equal keys.
+     *  \return The number of candidates removed.
+     */
+    template<class T, class Same>
+        size_t remove_copies( std::vector<T>& c, const std::vector<unsigned long>& key, Same& same ) 
+        { 
+            size_t N = c.size();
+            std::vector<size_t> idx( N );
+            for( size_t i = 0; i < N; ++i ) 
+                idx[i] = i;
+            std::sort( idx.begin(), idx.end(), key_order( key ) );
+
+            std::vector<char> removed( N, 0 );
+            for( size_t a = 0; a < N; ) { 
+                size_t b = a + 1;
+                while( b < N && key[ idx[b] ] == key[ idx[a] ] ) 
+                    ++b;
+                // compare against all kept candidates of the run
+                for( size_t x = a + 1; x < b; ++x ) 
+                    for( size_t y = a; y < x; ++y ) 
+                        if ( ! removed[ idx[y] ] && same( c[ idx[y] ], c[ idx[x] ] ) ) { 
+                            removed[ idx[x] ] = 1;
+                            break;
+                        }
+                a = b;
+            }
+
+            size_t out = 0;
+            for( size_t i = 0; i < N; ++i ) 
+                if ( ! removed[i] ) 
+                    c[ out++ ] = c[i];
+            c.erase( c.begin() + out, c.end() );
+            return N - out;
+        }
+
+} // namespace detail end
+
+} // namespace mcb end
+
+#endif  // ISOMETRIC_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
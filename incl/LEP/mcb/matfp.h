@@ -0,0 +1,208 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+
+/*! \file matfp.h
+ *  \brief Dense matrix with elements in \f$Z_p\f$ for a word prime \f$p\f$.
+ */
+
+#ifndef MATFP_H
+#define MATFP_H
+
+#include <vector>
+#include <utility>
+#include <LEP/mcb/config.h>
+#include <LEP/mcb/arithm.h>
+
+#ifdef MCB_LEP_WORD_PRIMES
+
+namespace mcb
+{
+
+namespace detail
+{ 
+
+    /*! The word type of the entries of a matfp. */
+    __extension__ typedef unsigned long long fpword;
+
+    /*! \brief A dense matrix with elements in \f$Z_p\f$, for a prime \f$p < 2^{32}\f$.
+     *
+     *  All rows are stored in one contiguous block of memory, one 64-bit word for 
+     *  each entry. A product of two elements fits in 64 bits and the sum of a reduced
+     *  entry with \f$K\f$ such products still fits, where \f$K\f$ is about 
+     *  \f$2^{64}/p^2\f$. Thus adding a multiple of a vector to a row is a plain 
+     *  multiply-add on each entry and the row is reduced modulo \f$p\f$ only after 
+     *  every \f$K\f$ additions.
+     *
+     *  Besides init() no operation allocates memory. The matrix uses 
+     *  \f$8 \cdot rows \cdot cols\f$ bytes of memory. Different rows can be updated
+     *  concurrently by different threads.
+     *
+     *  On x86 processors the multiply-add uses AVX-512 or AVX2 instructions if the 
+     *  processor supports them. The selection is performed at runtime and can be disabled
+     *  at compile time by defining MCB_LEP_NO_SIMD.
+     *
+     *  The directed algorithm uses this class to maintain the support vectors when 
+     *  mcb::DENSE_SUPPORT is requested. As in the undirected case the support vectors 
+     *  have non-zero entries only at the first \f$N\f$ indices, where \f$N\f$ is the 
+     *  dimension of the cycle space.
+     */
+    class matfp
+    {
+        public:
+            //@{
+            /*! Construct an empty matrix. */
+            matfp();
+
+            /*! Construct a zero matrix. 
+             *  \param rows The number of rows.
+             *  \param cols The number of columns.
+             *  \param p The prime.
+             *  \pre fits( p )
+             */
+            matfp( int rows, int cols, fpword p );
+
+            /*! Destructor */
+            ~matfp();
+            //@}
+
+            /*! Whether a prime is small enough. */
+            static bool fits( wptype p ) { 
+                return p > 1 && p < ( (wptype) 1 << 32 );
+            }
+
+            /*! Reinitialize as a zero matrix.
+             *  \param rows The number of rows.
+             *  \param cols The number of columns.
+             *  \param p The prime.
+             *  \pre fits( p )
+             */
+            void init( int rows, int cols, fpword p );
+
+            /*! Number of rows. */
+            int rows() const { return r; }
+
+            /*! Number of columns. */
+            int cols() const { return c; }
+
+            /*! The prime. */
+            fpword prime() const { return p; }
+
+            /*! Reduce a word modulo \f$p\f$. */
+            fpword reduce( fpword x ) const { 
+                __extension__ typedef unsigned __int128 dword;
+                fpword q = (fpword) ( ( (dword) x * mu ) >> 64 );
+                fpword y = x - q * p;
+                return ( y >= p ) ? y - p : y;
+            }
+
+            /*! Set entry \f$(i,j)\f$, the value must be in \f$[0,p)\f$. */
+            void set( int i, int j, fpword v ) { 
+                a[ (size_t) i * c + j ] = v;
+            }
+
+            /*! Get entry \f$(i,j)\f$ reduced modulo \f$p\f$. */
+            fpword get( int i, int j ) const { 
+                return reduce( a[ (size_t) i * c + j ] );
+            }
+
+            /*! Reduce all entries of row \f$i\f$ modulo \f$p\f$. */
+            void reduce_row( int i );
+
+            /*! Compute row \f$i\f$ times \f$s\f$, reduced modulo \f$p\f$.
+             *  \param i The row.
+             *  \param s A value in \f$[0,p)\f$.
+             *  \param out Where to write the result, must hold cols() words.
+             */
+            void scale_row( int i, fpword s, fpword* out ) const;
+
+            /*! Inner product of row \f$i\f$ with a sparse vector. 
+             *  \param i The row.
+             *  \param v The sparse vector as (index,value) pairs with values in \f$[0,p)\f$. 
+             *           Indices greater or equal to cols() are ignored.
+             *  \return The inner product in \f$[0,p)\f$.
+             */
+            fpword dot( int i, const std::vector< std::pair<indextype,wptype> >& v ) const;
+
+            /*! Subtract from every row \f$l\f$, \f$first \le l < last\f$, the vector 
+             *  \f$s\f$ times the inner product of row \f$l\f$ with a sparse vector. Each 
+             *  row is tested and updated in the same pass.
+             *  \param first The first row.
+             *  \param last One past the last row.
+             *  \param v The sparse vector as (index,value) pairs with values in \f$[0,p)\f$.
+             *  \param s A vector of cols() words with values in \f$[0,p)\f$.
+             */
+            void update_rows( int first, int last, 
+                    const std::vector< std::pair<indextype,wptype> >& v, const fpword* s );
+
+            /*! Read the non-zero entries of row \f$i\f$ reduced modulo \f$p\f$, as 
+             *  (index,value) pairs in increasing order of index. 
+             */
+            void get_row( int i, std::vector< std::pair<indextype,wptype> >& v ) const;
+
+        private:
+            fpword* row( int i ) { return &a[0] + (size_t) i * c; }
+            const fpword* row( int i ) const { return &a[0] + (size_t) i * c; }
+
+            int r, c;
+            fpword p;
+            fpword mu;                  // floor( 2^64 / p )
+            int limit;                  // additions a reduced row can take
+            std::vector<fpword> a;
+            std::vector<int> pending;   // additions since the last reduction of each row
+    };
+
+    //@{
+    /*! Multiply-add of vectors, \f$x = x + c \cdot y\f$, without any reduction.
+     *  \param x The vector to add to.
+     *  \param y The vector to add.
+     *  \param c A value less than \f$2^{32}\f$.
+     *  \param n The number of entries of both vectors.
+     *  \pre The entries of \f$y\f$ are less than \f$2^{32}\f$
+     */
+    void fp_axpy( fpword* x, const fpword* y, fpword c, int n );
+
+    /*! Name of the kernels selected for the current processor, one of "avx512", 
+     *  "avx2" or "generic". 
+     */
+    const char* fp_kernel_name();
+    //@}
+
+} // namespace detail end
+
+} // namespace mcb end
+
+#endif // MCB_LEP_WORD_PRIMES
+
+#endif  // MATFP_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
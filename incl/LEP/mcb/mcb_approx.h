@@ -77,7 +77,9 @@ namespace mcb
                     { 
                     }
 
-                virtual ~mcb_approx() {}
+                virtual ~mcb_approx() { 
+                    mcb::release_workspaces();
+                }
 
                 W run() { 
                     checkGraphPreconditions();
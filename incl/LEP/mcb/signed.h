@@ -34,28 +34,31 @@
 #define SIGNED_H
 
 #include <iostream>
-#include <stack>
+#include <vector>
+#include <algorithm>
+#include <climits>
 #include <LEP/mcb/config.h>
 
 #ifdef LEDA_GE_V5
 #include <LEDA/graph/graph.h>
-#include <LEDA/graph/node_pq.h>
+#include <LEDA/graph/node_array.h>
 #include <LEDA/core/array.h>
-#include <LEDA/core/queue.h>
+#include <LEDA/core/list.h>
 #include <LEDA/core/d_int_set.h>
-#include <LEDA/core/impl/f_heap.h>
-#include <LEDA/core/impl/bin_heap.h>
 #else
 #include <LEDA/graph.h>
+#include <LEDA/node_array.h>
 #include <LEDA/array.h>
-#include <LEDA/queue.h>
+#include <LEDA/list.h>
 #include <LEDA/d_int_set.h>
-#include <LEDA/node_pq.h>
-#include <LEDA/impl/f_heap.h>
-#include <LEDA/impl/bin_heap.h>
 #endif
 #include <LEP/mcb/edge_num.h>
 #include <LEP/mcb/spvecgf2.h>
+#include <LEP/mcb/bitmatgf2.h>
+#include <LEP/mcb/count_ptr.h>
+#include <LEP/mcb/heap.h>
+#include <LEP/mcb/workspace.h>
+#include <LEP/mcb/threads.h>
 
 namespace mcb 
 { 
@@ -67,8 +70,6 @@ namespace mcb
     using leda::array;
     using leda::list;
     using leda::list_item;
-    using leda::queue;
-    using leda::node_pq;
     using leda::edge;
     using leda::edge_array;
     using leda::d_int_set;
@@ -77,49 +78,85 @@ namespace mcb
 
     namespace detail {
 
-        template<class T_leaftype, typename W>
-            class SignedGraph
+        // Scratch space of a single shortest path computation in the signed 
+        // graph. Each thread uses its own object, the search arrays come from 
+        // the workspace pool and nodes of the signed graph are addressed by 
+        // their index.
+        template<typename W, class heap_type>
+            struct signed_search_state
             {
-                public: 
-                    typedef W result_type;
+                typedef search_workspace<W,heap_type> workspace_type;
+
+                pooled_workspace<workspace_type> fwd;   // search from the source
+                pooled_workspace<workspace_type> bwd;   // search from the target, bidirectional only
+                std::vector<unsigned> mark;     // edges of the path, indexed by edge number
+                unsigned stamp;                 // current mark
+                std::vector<int> path;          // edge numbers of the last checked path
+                int hide_from;                  // edges of the sign with rank >= hide_from are hidden
+                int meet;                       // node where the two searches meet, -1 if none
+
+                unsigned long settled;          // number of settled nodes, only with LEP_STATS
+
+                // frontiers of a direction optimizing bfs, one bit per node
+                std::vector<gf2word> frontier;
+                std::vector<gf2word> next_frontier;
+
+                void init( int n, int m ) { 
+                    hide_from = INT_MAX;
+                    fwd.acquire( n );
+                    mark.assign( m, 0 );
+                    stamp = 0;
+                    path.clear();
+                    meet = -1;
+                    settled = 0;
+                }
 
-                    SignedGraph( const graph& G, const edge_num& _enumb ) 
-                        : g(G), enumb(_enumb) 
-                    {
-                        init_signed_graph();
-                    }
+                void init_backward( int n ) { 
+                    bwd.acquire( n );
+                }
 
-                    void sign_edge( edge e ) {
-                        if ( Sold.member( enumb(e) ) ) return;
-                        node v = g.source(e);
-                        node u = g.target(e);
-                        sg.move_edge( epos[ e ] , pos[v] , neg[u] );
-                        sg.move_edge( eneg[ e ] , neg[v] , pos[u] );
-                        Sold.insert( enumb(e) );
-                    }
+                void init_frontiers( int n ) { 
+                    frontier.assign( ( n + gf2word_bits - 1 ) / gf2word_bits, 0 );
+                    next_frontier.assign( frontier.size(), 0 );
+                }
 
-                    void unsign_edge( edge e ) { 
-                        if ( Sold.member( enumb(e) ) == false ) return;
-                        node v = g.source(e);
-                        node u = g.target(e);
-                        sg.move_edge( epos[ e ] , pos[v], pos[u] );
-                        sg.move_edge( eneg[ e ] , neg[v], neg[u] );
-                        Sold.del( enumb(e) );
-                    }
+                void reset() { 
+                    fwd->start();
+                    if ( bwd.get() != 0 ) 
+                        bwd->start();
+                    meet = -1;
+                }
 
-                    void hide_edge( edge e ) { 
-                        sg.hide_edge( epos[e] ); 
-                        sg.hide_edge( eneg[e] ); 
+                void new_mark() { 
+                    if ( ++stamp == 0 ) {  // wrap around
+                        std::fill( mark.begin(), mark.end(), 0 );
+                        stamp = 1;
                     }
+                }
+            };
 
-                    void restore_edge( edge e ) { 
-                        sg.restore_edge( epos[e] ); 
-                        sg.restore_edge( eneg[e] ); 
-                    }
+        // The signed graph of an undirected graph G(V,E) with respect to a 
+        // sign S contains two copies v+ and v- of each vertex v. An edge (u,v) 
+        // not in S connects u+ with v+ and u- with v-, while an edge in S 
+        // connects u+ with v- and u- with v+. A shortest path from v+ to v- 
+        // corresponds to a shortest closed walk through v which uses an odd 
+        // number of edges of S.
+        //
+        // The signed graph is never built explicitly. The adjacency of G is 
+        // kept in compressed sparse row format, together with one sign bit per 
+        // edge, and the searches move between the states (v,parity). The 
+        // state (v,0) is v+ with index 2v and (v,1) is v- with index 2v+1.
+        template<class T_leaftype, typename W, class heap_type = binary_heap<W> >
+            class SignedGraph
+            {
+                public: 
+                    typedef W result_type;
+                    typedef signed_search_state<W,heap_type> state_type;
 
-                    bool is_hidden( edge e ) { 
-                        return sg.is_hidden( epos[e] ) || 
-                            sg.is_hidden( eneg[e] ); 
+                    SignedGraph( const graph& G, const edge_num& _enumb, int threads_ = 1 ) 
+                        : g(G), enumb(_enumb), threads( num_threads( threads_ ) )
+                    {
+                        init_signed_graph();
                     }
 
                     W get_shortest_odd_cycle( const d_int_set& S, d_int_set& C ) { 
@@ -132,6 +169,14 @@ namespace mcb
                         return find_shortest_cycle( S, C );
                     }
 
+                    // total number of nodes settled by all computations
+                    unsigned long settled() const { 
+                        unsigned long total = 0;
+                        for( size_t i = 0; i < states.size(); ++i ) 
+                            total += states[i]->settled;
+                        return total;
+                    }
+
                 protected:
 
                     T_leaftype& asLeaf() { 
@@ -162,367 +207,518 @@ namespace mcb
                             return find_shortest_cycle_n ( C );
                     }
 
-
-                    // run shortest path
-                    void run_sp( const node& s, const node& t, 
+                    // run shortest path between two states
+                    void run_sp( state_type& st, int s, int t, 
                             const W M, bool M_equals_infinity, 
                             W& D, bool& D_equals_infinity ) 
                     {
-                        asLeaf().run_sp( s, t, M, M_equals_infinity, D, D_equals_infinity );
+                        asLeaf().run_sp( st, s, t, M, M_equals_infinity, D, D_equals_infinity );
                     }
 
-                    // Find the currently shorter odd cycle, by n dijkstra computations. 
+                    // Find the currently shorter odd cycle, by n dijkstra computations 
+                    // from v+ to v-. The computations are distributed among the threads 
+                    // and each one is pruned by the best cycle found so far by any thread. 
+                    // Among the shortest valid cycles the one of the first vertex is 
+                    // returned, independently of the thread scheduling.
                     W find_shortest_cycle_n( d_int_set& C )
                     {
-                        W M = W(0), D = W(0);    // current minimum
-                        bool M_equals_infinity = true, D_equals_infinity = true;
+                        W M = W(0);                 // current minimum
+                        bool M_equals_infinity = true;
+                        int Mvertex = -1;           // and its vertex
+                        std::vector<int> Mpath;     // and its cycle
 
-                        // run n times dijkstra's algorithm
-                        node v;
-                        forall_nodes( v , g ) { 
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) if(threads > 1)
+#endif
+                        { 
+                            state_type& st = *states[ thread_num() ];
+                            W D = W(0), lM = W(0);
+                            bool D_equals_infinity = true, lM_equals_infinity = true;
 
-                            run_sp( pos[v], neg[v], 
-                                    M, M_equals_infinity, 
-                                    D, D_equals_infinity );
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+                            for( int v = 0; v < n; ++v ) { 
+#ifdef _OPENMP
+#pragma omp critical(mcb_signed_bound)
+#endif
+                                { 
+                                    lM = M;
+                                    lM_equals_infinity = M_equals_infinity;
+                                }
 
-                            // update global min
-                            if ( ! D_equals_infinity ) {
-                                if ( M_equals_infinity ) { 
-                                    if ( check_valid( neg[v], pred, C ) ) { 
+                                run_sp( st, 2*v, 2*v+1, 
+                                        lM, lM_equals_infinity, 
+                                        D, D_equals_infinity );
+
+                                if ( D_equals_infinity ) 
+                                    continue;
+                                if ( ! lM_equals_infinity && lM < D ) 
+                                    continue;
+                                if ( ! check_valid( st, 2*v+1 ) ) 
+                                    continue;
+
+#ifdef _OPENMP
+#pragma omp critical(mcb_signed_bound)
+#endif
+                                { 
+                                    if ( M_equals_infinity || D < M || ( ! ( M < D ) && v < Mvertex ) ) { 
                                         M = D;
                                         M_equals_infinity = false;
-                                    }
-                                }
-                                else {
-                                    if ( D < M ) { 
-                                        if ( check_valid( neg[v], pred, C ) ) { 
-                                            M = D;
-                                        }
+                                        Mvertex = v;
+                                        Mpath = st.path;
                                     }
                                 }
                             }
                         }
+
+                        if ( ! M_equals_infinity ) { 
+                            C.clear();
+                            for( size_t j = 0; j < Mpath.size(); ++j ) 
+                                C.insert( Mpath[j] );
+                        }
                         return M;
                     }
 
-
+                    // Find the currently shorter odd cycle, by one dijkstra computation 
+                    // for each edge of the sign. The computation of the i-th edge (u,v) 
+                    // of the sign finds a shortest path from u+ to v+ ignoring the edges 
+                    // of the sign with rank at least i. Every odd cycle is found by the 
+                    // computation of its edge of the sign with largest rank.
+                    // 
+                    // The computations are distributed among the threads, ties are 
+                    // resolved in favor of the lowest rank.
                     W find_shortest_cycle_k( d_int_set& C ) { 
-                        // initialize
-                        W M = W(0), D = W(0);
-                        bool M_equals_infinity = true, D_equals_infinity = true;
-
-                        // get edge list and hide edges
-                        edge e;
-                        list<int> L;
-                        Sold.get_element_list( L );
-                        int i;
-                        forall(i,L) hide_edge( enumb(i) ); 
+                        W M = W(0);
+                        bool M_equals_infinity = true;
+                        int Mrank = -1;
+                        std::vector<int> Mpath;
 
-                        // now do the computations
-                        forall(i,L) { 
-                            e = enumb(i);
+                        int k = (int) Sold.size();
+                        for( int r = 0; r < k; ++r ) 
+                            srank[ Sold[r] ] = r;
 
-                            // NOTE:
-                            // M is an upper bound on the previous cycles found
-                            // In this case M is not exactly tight, since dijkstra 
-                            // is finding a path which is missing an edge in order 
-                            // to be a cycle.
-                            // I do not see however a clean way to make it more tight.
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) if(threads > 1)
+#endif
+                        { 
+                            state_type& st = *states[ thread_num() ];
+                            W D = W(0), lM = W(0);
+                            bool D_equals_infinity = true, lM_equals_infinity = true;
 
-                            run_sp( pos[ g.source(e) ], 
-                                    pos[ g.target(e) ], 
-                                    M, M_equals_infinity, 
-                                    D, D_equals_infinity );
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+                            for( int r = 0; r < k; ++r ) { 
+                                int j = Sold[r];
+#ifdef _OPENMP
+#pragma omp critical(mcb_signed_bound)
+#endif
+                                { 
+                                    lM = M;
+                                    lM_equals_infinity = M_equals_infinity;
+                                }
 
-                            restore_edge( e );
+                                // NOTE:
+                                // M is an upper bound on the previous cycles found
+                                // In this case M is not exactly tight, since dijkstra 
+                                // is finding a path which is missing an edge in order 
+                                // to be a cycle.
+                                // I do not see however a clean way to make it more tight.
+
+                                st.hide_from = r;
+                                run_sp( st, 2*esrc[j], 2*etgt[j], 
+                                        lM, lM_equals_infinity, 
+                                        D, D_equals_infinity );
+                                st.hide_from = INT_MAX;
+
+                                if ( D_equals_infinity ) 
+                                    continue;
+                                W c = D + edge_length( j );
+                                if ( ! lM_equals_infinity && lM < c ) 
+                                    continue;
+                                if ( ! check_valid( st, 2*etgt[j] ) ) 
+                                    continue;
+
+#ifdef _OPENMP
+#pragma omp critical(mcb_signed_bound)
+#endif
+                                { 
+                                    if ( M_equals_infinity || c < M || ( ! ( M < c ) && r < Mrank ) ) { 
+                                        M = c;
+                                        M_equals_infinity = false;
+                                        Mrank = r;
+                                        Mpath = st.path;
+                                    }
+                                }
+                            }
+                        }
 
-                            if ( D_equals_infinity == true ) 
-                                continue;
-                            if ( M_equals_infinity == false && 
-                                    M <= D + edge_length(e) ) 
-                                continue;
-                            if ( check_valid( pos[ g.target(e) ], pred, C ) == false ) 
-                                continue;
-                            C.insert( i );
-                            M = D + edge_length(e);
-                            M_equals_infinity = false;
+                        for( int r = 0; r < k; ++r ) 
+                            srank[ Sold[r] ] = -1;
+
+                        if ( ! M_equals_infinity ) { 
+                            C.clear();
+                            for( size_t j = 0; j < Mpath.size(); ++j ) 
+                                C.insert( Mpath[j] );
+                            C.insert( Sold[ Mrank ] );
                         }
                         return M;
                     }
 
-
-
-                    bool check_valid(node u, node_array<edge>& pred, d_int_set& V) 
+                    // Check that the path ending at state u uses each edge at most
+                    // once. The edges of the path are left in st.path. After a 
+                    // bidirectional computation the path consists of the two tree 
+                    // paths from the meeting node.
+                    bool check_valid( state_type& st, int u ) 
                     {
-                        Stemp.clear();
-                        node t = u;
-                        while (pred[t] != nil ) {
-                            if ( Stemp.member( enumb( remap[ pred[t] ] ) ) ) { 
-                                return false;
-                            } 
-                            else Stemp.insert( enumb( remap[ pred[t] ] ) );
-                            t = sg.opposite( pred[ t ], t );
+                        st.new_mark();
+                        st.path.clear();
+                        if ( st.meet >= 0 ) { 
+                            return walk_path( st, *st.fwd, st.meet ) && 
+                                walk_path( st, *st.bwd, st.meet ) && 
+                                st.path.size() > 0;
                         }
-                        if ( Stemp.size() > 0 ) { 
-                            V = Stemp;
-                            return true;
+                        return walk_path( st, *st.fwd, u ) && st.path.size() > 0;
+                    }
+
+                    // mark the edges of a tree path, false if an edge is found twice
+                    bool walk_path( state_type& st, const typename state_type::workspace_type& ws, int u ) 
+                    { 
+                        for( int t = u; ws.pred[ t ] >= 0; t = ws.pred[ t ] ) { 
+                            int j = ws.pred_edge[ t ];
+                            if ( st.mark[ j ] == st.stamp ) 
+                                return false;
+                            st.mark[ j ] = st.stamp;
+                            st.path.push_back( j );
                         }
-                        return false;
+                        return true;
                     }
 
-                    void switch_sign( const d_int_set& S ) { 
-                        int i;
+                    // whether an edge is hidden for the computation of a thread
+                    bool is_hidden( const state_type& st, int j ) const { 
+                        return srank[ j ] >= st.hide_from;
+                    }
 
-                        list<int> Lold;
-                        Sold.get_element_list( Lold );
-                        forall(i,Lold)
-                            unsign_edge( enumb(i) );
+                    void unsign_all() { 
+                        for( size_t i = 0; i < Sold.size(); ++i ) 
+                            sign[ Sold[i] ] = 0;
+                        Sold.clear();
+                    }
+
+                    void sign_edge( int j ) { 
+                        if ( sign[ j ] ) return;
+                        sign[ j ] = 1;
+                        Sold.push_back( j );
+                    }
 
+                    void switch_sign( const d_int_set& S ) { 
+                        int i;
+                        unsign_all();
                         list<int> Lnew;
                         S.get_element_list( Lnew );
                         forall(i,Lnew)
-                            sign_edge( enumb(i) );
+                            sign_edge( i );
+                        std::sort( Sold.begin(), Sold.end() );
                     }
 
                     void switch_sign( const spvecgf2& S ) { 
                         int i;
-
-                        list<int> Lold;
-                        Sold.get_element_list( Lold );
-                        forall(i,Lold)
-                            unsign_edge( enumb(i) );
-
+                        unsign_all();
                         forall(i,S)
-                            sign_edge( enumb(i) );
+                            sign_edge( i );
+                        std::sort( Sold.begin(), Sold.end() );
                     }
 
-                    // init signed graph without edge lengths
+                    // build the adjacency of g in compressed sparse row format
                     void init_signed_graph() { 
                         node v; edge e;
 
-                        // initialize mapping
-                        pos.init( g ); neg.init( g ); epos.init( g ); eneg.init( g );
-                        forall_nodes( v , g ) { 
-                            pos[ v ] = sg.new_node(); 
-                            neg[ v ] = sg.new_node(); 
+                        n = g.number_of_nodes();
+                        m = g.number_of_edges();
+
+                        node_array<int> id( g, 0 );
+                        int i = 0;
+                        forall_nodes( v , g ) 
+                            id[ v ] = i++;
+
+                        esrc.resize( m ); 
+                        etgt.resize( m );
+                        first.assign( n + 1, 0 );
+                        forall_edges( e , g ) { 
+                            int j = enumb( e );
+                            esrc[ j ] = id[ g.source( e ) ];
+                            etgt[ j ] = id[ g.target( e ) ];
+                            ++first[ esrc[ j ] + 1 ];
+                            ++first[ etgt[ j ] + 1 ];
+                        }
+                        for( i = 0; i < n; ++i ) 
+                            first[ i + 1 ] += first[ i ];
+
+                        adj_node.resize( 2 * m );
+                        adj_edge.resize( 2 * m );
+                        std::vector<int> next( first.begin(), first.end() - 1 );
+                        for( int j = 0; j < m; ++j ) { 
+                            int a = next[ esrc[j] ]++;
+                            adj_node[ a ] = etgt[ j ];
+                            adj_edge[ a ] = j;
+                            a = next[ etgt[j] ]++;
+                            adj_node[ a ] = esrc[ j ];
+                            adj_edge[ a ] = j;
                         }
-                        remap.init( sg , 2*g.number_of_edges(), nil );
 
                         // initialize sign to the empty sign
-                        forall_edges( e , g ) { 
-                            edge e1 = sg.new_edge( pos[ g.source(e) ], pos [ g.target(e) ] ) ;
-                            epos[ e ] = e1;
-                            edge e2 = sg.new_edge( neg[ g.source(e) ], neg [ g.target(e) ] );
-                            eneg[ e ] = e2;
-                            remap[ e1 ] = e;
-                            remap[ e2 ] = e;
+                        sign.assign( m, 0 );
+                        srank.assign( m, -1 );
+
+                        // one scratch space per thread
+                        for( i = 0; i < threads; ++i ) { 
+                            states.push_back( count_ptr<state_type>( new state_type() ) );
+                            states[i]->init( 2 * n, m );
                         }
                     }
 
                     // get the length of an edge
-                    W edge_length( const edge& e ) { 
-                        return asLeaf().edge_length( e );
-                    }
-
-                    // init priority queue
-                    void initPQ() { 
-                        asLeaf().initPQ();
+                    W edge_length( int j ) { 
+                        return asLeaf().edge_length( j );
                     }
 
                     // Mapping related
                     const graph& g; // the original graph
                     const edge_num& enumb;
-                    graph sg; 
-
-                    // positive nodes (indexed by g, returns nodes by sg)
-                    node_array<node> pos; 
-                    // negative nodes (indexed by g, returns nodes by sg)
-                    node_array<node> neg; 
-                    // two edges for each edge (indexed by g, returns edges by sg)
-                    edge_array<edge> epos,eneg;  
-                    // reverse edge mapping (indexed by sg, returns edges by g)
-                    edge_array<edge> remap; 
-                    // sign, indexed by g
-                    d_int_set Sold,Stemp;
-
-                    std::stack<node> touched;               // keep track of changes
-                    node_array<edge> pred;             // predecessor
-
+                    int n, m;
+
+                    // adjacency of g, vertices numbered in iteration order 
+                    // and edges by the edge numbering
+                    std::vector<int> first;         // first arc of each vertex, size n+1
+                    std::vector<int> adj_node;      // opposite vertex of each arc
+                    std::vector<int> adj_edge;      // edge number of each arc
+                    std::vector<int> esrc, etgt;    // endpoints of each edge
+
+                    // the sign, one bit per edge number, and its edges in increasing order
+                    std::vector<unsigned char> sign;
+                    std::vector<int> Sold;
+                    // rank of each edge number in the current sign, or -1
+                    std::vector<int> srank;
+
+                    // parallel computations
+                    int threads;
+                    std::vector< count_ptr<state_type> > states;
             };
 
 
 
-        template<class W, class prio_impl=leda::bin_heap>
-            class WeightedSignedGraph : public SignedGraph< WeightedSignedGraph<W,prio_impl>, W >
+        template<class W, class heap_type = binary_heap<W> >
+            class WeightedSignedGraph : public SignedGraph< WeightedSignedGraph<W,heap_type>, W, heap_type >
         {
             public:
-                typedef SignedGraph< WeightedSignedGraph<W, prio_impl>, W> base_type;
+                typedef SignedGraph< WeightedSignedGraph<W,heap_type>, W, heap_type > base_type;
+                typedef typename base_type::state_type state_type;
 
-                WeightedSignedGraph( const graph& G, const edge_array<W>& len, const edge_num& _enumb ) 
-                    : SignedGraph< WeightedSignedGraph<W,prio_impl>, W >( G, _enumb ) 
+                WeightedSignedGraph( const graph& G, const edge_array<W>& len, const edge_num& _enumb, 
+                        int threads_ = 1, bool bidirectional_ = false ) 
+                    : base_type( G, _enumb, threads_ ), bidirectional( bidirectional_ )
                 {
-                    zero_length_edges = false;
-                    sg_len.init( sg , 2 * g.number_of_edges(), 0 );
-
                     // initialize edge lengths
+                    elen.resize( m );
                     edge e;
-                    forall_edges( e , g ) { 
-                        sg_len[ epos[ e ] ] = len[ e ];
-                        sg_len[ eneg[ e ] ] = len[ e ];
-                        zero_length_edges = (zero_length_edges==false)?
-                            ( len[ e ] == 0 ):(zero_length_edges);
-                    }
-                    if ( sg.number_of_nodes() > 0 ) 
-                        pq = new node_pq<W,graph,prio_impl>( sg );
-                    else 
-                        pq = nil;
-                    init_all_dijkstra();
+                    forall_edges( e , g ) 
+                        elen[ enumb( e ) ] = len[ e ];
+
+                    adj_len.resize( 2 * m );
+                    for( int a = 0; a < 2 * m; ++a ) 
+                        adj_len[ a ] = elen[ adj_edge[ a ] ];
+
+                    // storage of the backward searches
+                    if ( bidirectional ) 
+                        for( size_t i = 0; i < states.size(); ++i ) 
+                            states[i]->init_backward( 2 * n );
+                }
+
+                void run_sp( state_type& st, int s, int t, 
+                        const W M, bool M_equals_infinity, 
+                        W& D, bool& D_equals_infinity ) {
+                    if ( bidirectional ) 
+                        run_bidirectional_sp( st, s, t, M, M_equals_infinity, D, D_equals_infinity );
+                    else
+                        run_unidirectional_sp( st, s, t, M, M_equals_infinity, D, D_equals_infinity );
                 }
 
-                ~WeightedSignedGraph() {
-                    if ( pq != nil )
-                        delete pq;
+                // get the length of an edge
+                W edge_length( int j ) { 
+                    return elen[ j ];
                 }
 
-                void run_sp( const node& s, const node& t, 
+            private:
+
+                typedef typename state_type::workspace_type workspace_type;
+
+                void run_unidirectional_sp( state_type& st, int s, int t, 
                         const W M, bool M_equals_infinity, 
                         W& D, bool& D_equals_infinity ) {
-                    node u,w;
-                    edge e;
+                    workspace_type& f = *st.fwd;
+                    st.reset();
                     D = W();
                     D_equals_infinity = ( s != t )? true : false;
-                    init_used_dijkstra();
-                    pred[s] = nil;
-                    dist[s] = 0;
-                    touched.push( s );
+                    f.reach( s, 0, -1, -1 );
                     if ( D_equals_infinity == false ) return;
-                    pq->insert( s, 0 );
+                    f.heap.insert( s, 0 );
 
                     // start removing from queue
-                    while( ! pq->empty() ) {
-                        u = pq->del_min();       // get min 
+                    while( ! f.heap.empty() ) {
+                        int u = f.heap.del_min();       // get min 
+#ifdef LEP_STATS
+                        ++st.settled;
+#endif
 
                         if ( u == t ) { // found target
                             D_equals_infinity = false;
-                            D = dist[ u ];
+                            D = f.dist[ u ];
                             return;
                         }     
 
                         // update keys in queue, or add if necessary
-                        if ( sg.is_undirected() ) {
-                            // code duplication due to LEDA-6.0 change in macro
-                            // forall_inout_edges
-                            // Prior to 6.0 only one loop with forall_inout_edges worked
-                            // for both undirected and directed graphs
-                            forall_adj_edges( e , u ) {
-                                w = sg.opposite( u, e );
-                                W c = dist[ u ] + sg_len[ e ];
+                        int x = u >> 1, p = u & 1;
+                        for( int a = first[ x ]; a < first[ x + 1 ]; ++a ) { 
+                            int j = adj_edge[ a ];
+                            if ( this->is_hidden( st, j ) ) 
+                                continue;
+                            int w = 2 * adj_node[ a ] + ( p ^ sign[ j ] );
+                            W c = f.dist[ u ] + adj_len[ a ];
 
 #if !defined(LEDA_CHECKING_OFF)
-                                if ( c < 0 )
-                                    error_handler(999,"MIN_CYCLE_BASIS:\
-                                            negative distance (overflow)");
+                            if ( c < 0 )
+                                error_handler(999,"MIN_CYCLE_BASIS: negative distance (overflow)");
 #endif
 
-                                if ( pred[ w ] == nil && w != s ) {  // add
+                            if ( ! f.reached( w ) ) {  // add
 #ifndef MCB_LEP_UNDIR_NO_SP_HEURISTIC
-                                    // never insert if more than current minimum
-                                    if ( (! M_equals_infinity) && ( c > M ) ) 
-                                        continue;
+                                // never insert if more than current minimum
+                                if ( (! M_equals_infinity) && ( c > M ) ) 
+                                    continue;
 #endif
-                                    pq->insert( w , c );  // first path to w
-                                    touched.push( w );    // record change
-                                }
-                                else if (  c < dist[ w ] ) {  // decrease key
-                                    pq->decrease_p( w, c );
-                                }
-                                else continue;
-
-                                dist[ w ] = c;
-                                pred[ w ] = e;
+                                f.heap.insert( w , c );  // first path to w
                             }
-                        }
-                        else { 
-                            forall_inout_edges( e , u ) {
-                                w = sg.opposite( u, e );
-                                W c = dist[ u ] + sg_len[ e ];
+                            else if (  c < f.dist[ w ] ) {  // decrease key
+                                f.heap.decrease_p( w, c );
+                            }
+                            else continue;
 
-#if !defined(LEDA_CHECKING_OFF)
-                                if ( c < 0 )
-                                    error_handler(999,"MIN_CYCLE_BASIS:\
-                                            negative distance (overflow)");
-#endif
+                            f.reach( w, c, u, j );
+                        }
+                    }
+                }
 
-                                if ( pred[ w ] == nil && w != s ) {  // add
+                // Run dijkstra simultaneously from s and from t, settling each time 
+                // the node with the smaller key, the forward one on equal keys. The 
+                // signed graph is undirected, so the backward search uses the same 
+                // arcs. The computation stops as soon as the sum of the minimum keys 
+                // of the two queues is at least the length of the shortest path seen 
+                // so far, or exceeds the upper bound M.
+                //
+                // The bound M only keeps nodes with keys larger than M out of the 
+                // queues and such nodes are never settled. Therefore whenever a path 
+                // of length at most M exists, the order in which the nodes are settled 
+                // and thus the path found do not depend on M, which differs among 
+                // the threads.
+                void run_bidirectional_sp( state_type& st, int s, int t, 
+                        const W M, bool M_equals_infinity, 
+                        W& D, bool& D_equals_infinity ) {
+                    workspace_type& f = *st.fwd;
+                    workspace_type& b = *st.bwd;
+                    st.reset();
+                    D = W();
+                    D_equals_infinity = ( s != t )? true : false;
+                    f.reach( s, 0, -1, -1 );
+                    if ( D_equals_infinity == false ) return;
+                    b.reach( t, 0, -1, -1 );
+                    f.heap.insert( s, 0 );
+                    b.heap.insert( t, 0 );
+
+                    while( ! f.heap.empty() && ! b.heap.empty() ) { 
+                        W fmin = f.heap.prio( f.heap.find_min() );
+                        W bmin = b.heap.prio( b.heap.find_min() );
+                        W top = fmin + bmin;
+                        if ( ! D_equals_infinity && ! ( top < D ) ) 
+                            break;
 #ifndef MCB_LEP_UNDIR_NO_SP_HEURISTIC
-                                    // never insert if more than current minimum
-                                    if ( (! M_equals_infinity) && ( c > M ) ) 
-                                        continue;
+                        if ( (! M_equals_infinity) && ( top > M ) ) 
+                            break;
 #endif
-                                    pq->insert( w , c );  // first path to w
-                                    touched.push( w );    // record change
-                                }
-                                else if (  c < dist[ w ] ) {  // decrease key
-                                    pq->decrease_p( w, c );
-                                }
-                                else continue;
 
-                                dist[ w ] = c;
-                                pred[ w ] = e;
-                            }
-                        }
+                        if ( ! ( bmin < fmin ) ) 
+                            settle( st, f, b, M, M_equals_infinity, D, D_equals_infinity );
+                        else
+                            settle( st, b, f, M, M_equals_infinity, D, D_equals_infinity );
                     }
                 }
 
-                // get the length of an edge
-                W edge_length( const edge& e ) { 
-                    return sg_len[ epos[e] ];
-                }
+                // settle the minimum node of one direction of a bidirectional 
+                // computation and record any shorter path through the other direction
+                void settle( state_type& st, workspace_type& ws, const workspace_type& other, 
+                        const W M, bool M_equals_infinity, 
+                        W& D, bool& D_equals_infinity ) 
+                { 
+                    int u = ws.heap.del_min();
+#ifdef LEP_STATS
+                    ++st.settled;
+#endif
 
-            private:
+                    int x = u >> 1, p = u & 1;
+                    for( int a = first[ x ]; a < first[ x + 1 ]; ++a ) { 
+                        int j = adj_edge[ a ];
+                        if ( this->is_hidden( st, j ) ) 
+                            continue;
+                        int w = 2 * adj_node[ a ] + ( p ^ sign[ j ] );
+                        W c = ws.dist[ u ] + adj_len[ a ];
 
-                void initPQ() {
-                    if ( pq != nil )
-                        pq->clear();
-                } 
-
-                // init all dijkstra's data
-                void init_all_dijkstra() { 
-                    dist.init( sg, 0 ); 
-                    pred.init( sg, nil ); 
-                    while( ! touched.empty() ) 
-                        touched.pop();
-                    initPQ();
-                }
+#if !defined(LEDA_CHECKING_OFF)
+                        if ( c < 0 )
+                            error_handler(999,"MIN_CYCLE_BASIS: negative distance (overflow)");
+#endif
 
+                        if ( ! ws.reached( w ) ) {  // add
+#ifndef MCB_LEP_UNDIR_NO_SP_HEURISTIC
+                            // never insert if more than current minimum
+                            if ( (! M_equals_infinity) && ( c > M ) ) 
+                                continue;
+#endif
+                            ws.heap.insert( w , c );
+                        }
+                        else if ( c < ws.dist[ w ] ) {  // decrease key
+                            ws.heap.decrease_p( w, c );
+                        }
+                        else continue;
 
-                // init only used dijkstra's data
-                void init_used_dijkstra() { 
-                    while( ! touched.empty() ) { 
-                        node w = touched.top();
-                        touched.pop(); 
-                        dist[w] = 0; 
-                        pred[ w ] = nil;  
+                        ws.reach( w, c, u, j );
+
+                        // reached by the other direction?
+                        if ( other.reached( w ) ) { 
+                            W l = c + other.dist[ w ];
+                            if ( D_equals_infinity || l < D ) { 
+                                D = l;
+                                D_equals_infinity = false;
+                                st.meet = w;
+                            }
+                        }
                     }
-                    initPQ();
                 }
 
-                // lengths
-                edge_array<W> sg_len; 
-                // do zero length edges exist?
-                bool zero_length_edges; 
+                bool bidirectional;
 
-                // distances
-                node_array<W> dist;                // distance
-                node_pq<W,graph,prio_impl> *pq;    // priority queue
+                // lengths by edge number and by arc
+                std::vector<W> elen, adj_len;
 
                 // from parent class
                 using base_type::g; 
-                using base_type::sg; 
-                using base_type::epos;
-                using base_type::eneg;
-                using base_type::touched;
-                using base_type::pred; 
+                using base_type::enumb; 
+                using base_type::n; 
+                using base_type::m; 
+                using base_type::first;
+                using base_type::adj_node;
+                using base_type::adj_edge;
+                using base_type::sign;
+                using base_type::states;
         }; 
 
 
@@ -531,115 +727,172 @@ namespace mcb
                 typedef SignedGraph< UnweightedSignedGraph, int> base_type;
 
             public:
-                UnweightedSignedGraph( const graph& G, const edge_num& _enumb )
-                    : SignedGraph<UnweightedSignedGraph, int>( G, _enumb ) 
+
+                UnweightedSignedGraph( const graph& G, const edge_num& _enumb, int threads_ = 1 )
+                    : SignedGraph<UnweightedSignedGraph, int>( G, _enumb, threads_ ) 
                 {
-                    init_all_dijkstra();
+                    for( size_t i = 0; i < states.size(); ++i ) 
+                        states[i]->init_frontiers( 2 * n );
                 }
 
-                // do an unweighted shortest path computation by doing
-                // a BFS procedure.
-                // consider the pred[e] array as the visited array
-                void run_sp( const node& s, const node& t, 
+                // Do an unweighted shortest path computation by a direction 
+                // optimizing BFS. Each level is expanded either top-down, from 
+                // the nodes of the frontier, or bottom-up, by looking for a 
+                // neighbor in the frontier from each unreached node. Bottom-up 
+                // is used once the arcs of the frontier are more than the arcs 
+                // of the unreached nodes, until the frontier becomes small, which 
+                // happens in the middle levels of graphs with small diameter. 
+                // The usual threshold of a fraction of the unreached arcs is too 
+                // eager here, since the search stops at the target.
+                void run_sp( state_type& st, int s, int t, 
                         int M, bool M_equals_infinity, 
                         int& D, bool& D_equals_infinity ) 
                 { 
+                    state_type::workspace_type& f = *st.fwd;
+
                     // initialize
-                    node u,w;
-                    edge e;
+                    st.reset();
                     D = 0;
                     D_equals_infinity = ( s != t )? true : false;
-                    init_used_dijkstra();
-                    pred[s] = nil;
-                    dist[s] = 0;
-                    touched.push( s );
+                    f.reach( s, 0, -1, -1 );
                     if ( D_equals_infinity == false ) return;
-                    Q.append( s );
+                    f.queue.push_back( s );
+                    set( st.frontier, s );
 
-                    // start computation
-                    while( Q.empty() == false ) {
-                        u = Q.pop();
+                    // arcs of the unreached nodes
+                    long unexplored = 4L * m - degree( s );
+                    bool bottom_up = false;
+                    size_t begin = 0;
+                    int level = 0;
 
-                        // found target?
-                        if ( u == t ) { 
-                            D = dist[ u ];
-                            D_equals_infinity = false;
-                            return;
-                        }
+                    // start computation
+                    while( begin < f.queue.size() && D_equals_infinity ) { 
+                        size_t end = f.queue.size();
 
                         // if we reach upper bound, exit immediately
-                        if ( M_equals_infinity == false && dist[u] > M )
-                            return;
-
-                        // visit neighbors
-                        if ( sg.is_undirected() ) {
-                            // code duplication due to LEDA-6.0 change in macro
-                            // forall_inout_edges
-                            // Prior to 6.0 only one look with forall_inout_edges worked
-                            // for both undirected and directed graphs
-                            forall_adj_edges( e, u ) {
-                                w = sg.opposite( e, u );
-                                if ( w != s && pred[ w ] == nil ) { 
-                                    pred[ w ] = e;
-                                    dist[ w ] = dist[ u ] + 1;
-                                    touched.push( w );
-                                    Q.append( w );
-                                }
-                            }
+                        if ( M_equals_infinity == false && level > M )
+                            break;
+
+                        // choose direction
+                        long scout = 0;
+                        for( size_t i = begin; i < end; ++i ) 
+                            scout += degree( f.queue[ i ] );
+                        if ( ! bottom_up && scout > unexplored ) 
+                            bottom_up = true;
+                        else if ( bottom_up && (long) ( end - begin ) < 2L * n / 24 ) 
+                            bottom_up = false;
+
+                        // the target is in the next level iff it has a neighbor in 
+                        // the frontier, in which case the level need not be expanded
+                        if ( ! adopt( st, f, t, unexplored ) ) { 
+                            if ( bottom_up ) 
+                                bottom_up_step( st, f, t, unexplored );
+                            else
+                                top_down_step( st, f, t, begin, end, unexplored );
                         }
-                        else {
-                            forall_inout_edges( e, u ) {
-                                w = sg.opposite( e, u );
-                                if ( w != s && pred[ w ] == nil ) { 
-                                    pred[ w ] = e;
-                                    dist[ w ] = dist[ u ] + 1;
-                                    touched.push( w );
-                                    Q.append( w );
-                                }
-                            }
+
+                        if ( f.reached( t ) ) { 
+                            D = f.dist[ t ];
+                            D_equals_infinity = false;
                         }
+
+                        // advance a level
+                        for( size_t i = begin; i < end; ++i ) 
+                            unset( st.frontier, f.queue[ i ] );
+                        st.frontier.swap( st.next_frontier );
+                        begin = end;
+                        ++level;
                     }
+
+                    // clear the frontier of the last level
+                    for( size_t i = begin; i < f.queue.size(); ++i ) 
+                        unset( st.frontier, f.queue[ i ] );
                 }
 
                 // get the length of an edge
-                int edge_length( const edge& e ) { 
+                int edge_length( int ) { 
                     return 1;
                 }
 
             private:
-                void initPQ() {
-                    Q.clear();
+                typedef state_type::workspace_type workspace_type;
+
+                int degree( int u ) const { 
+                    return first[ ( u >> 1 ) + 1 ] - first[ u >> 1 ];
                 }
 
-                // init all dijkstra's data
-                void init_all_dijkstra() { 
-                    dist.init( sg, 0 ); 
-                    pred.init( sg, nil ); 
-                    while( ! touched.empty() ) 
-                        touched.pop();
-                    initPQ();
+                static void set( std::vector<gf2word>& b, int u ) { 
+                    b[ u / gf2word_bits ] |= (gf2word) 1 << ( u % gf2word_bits );
                 }
 
-                // init only used dijkstra's data
-                void init_used_dijkstra() { 
-                    while( ! touched.empty() ) { 
-                        node w = touched.top();
-                        touched.pop(); 
-                        dist[w] = 0; 
-                        pred[ w ] = nil;  
-                    }       
-                    initPQ();
+                static void unset( std::vector<gf2word>& b, int u ) { 
+                    b[ u / gf2word_bits ] &= ~( (gf2word) 1 << ( u % gf2word_bits ) );
                 }
 
-                // distances
-                node_array<int> dist;
-                // priority queue for unweighted shortest paths
-                queue<node> Q;     
+                static bool test( const std::vector<gf2word>& b, int u ) { 
+                    return ( b[ u / gf2word_bits ] >> ( u % gf2word_bits ) ) & 1;
+                }
 
-                // from parent class
-                using base_type::sg; 
-                using base_type::touched;
-                using base_type::pred; 
+                // reach w from u, record it in the next frontier
+                void visit( state_type& st, workspace_type& f, int u, int w, int j, long& unexplored ) 
+                { 
+                    f.reach( w, f.dist[ u ] + 1, u, j );
+                    f.queue.push_back( w );
+                    set( st.next_frontier, w );
+                    unexplored -= degree( w );
+                }
+
+                void top_down_step( state_type& st, workspace_type& f, int t, 
+                        size_t begin, size_t end, long& unexplored ) 
+                { 
+                    for( size_t i = begin; i < end; ++i ) { 
+                        int u = f.queue[ i ];
+#ifdef LEP_STATS
+                        ++st.settled;
+#endif
+                        int x = u >> 1, p = u & 1;
+                        for( int a = first[ x ]; a < first[ x + 1 ]; ++a ) { 
+                            int j = adj_edge[ a ];
+                            if ( is_hidden( st, j ) ) 
+                                continue;
+                            int w = 2 * adj_node[ a ] + ( p ^ sign[ j ] );
+                            if ( ! f.reached( w ) ) { 
+                                visit( st, f, u, w, j, unexplored );
+                                if ( w == t ) 
+                                    return;
+                            }
+                        }
+                    }
+                }
+
+                void bottom_up_step( state_type& st, workspace_type& f, int t, long& unexplored ) 
+                { 
+                    for( int w = 0; w < 2 * n; ++w ) { 
+                        if ( ! f.reached( w ) && adopt( st, f, w, unexplored ) && w == t ) 
+                            return;
+                    }
+                }
+
+                // reach the unreached node w from a neighbor in the frontier, 
+                // false if there is none
+                bool adopt( state_type& st, workspace_type& f, int w, long& unexplored ) 
+                { 
+#ifdef LEP_STATS
+                    ++st.settled;
+#endif
+                    int x = w >> 1, p = w & 1;
+                    for( int a = first[ x ]; a < first[ x + 1 ]; ++a ) { 
+                        int j = adj_edge[ a ];
+                        if ( is_hidden( st, j ) ) 
+                            continue;
+                        int u = 2 * adj_node[ a ] + ( p ^ sign[ j ] );
+                        if ( test( st.frontier, u ) ) { 
+                            visit( st, f, u, w, j, unexplored );
+                            return true;
+                        }
+                    }
+                    return false;
+                }
         };
 
     } // namespace detail end
@@ -649,5 +902,3 @@ namespace mcb
 #endif
 
 /* ex: set ts=4 sw=4 sts=4 et: */
-
-
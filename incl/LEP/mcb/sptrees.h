@@ -46,26 +46,25 @@
 #include <LEP/mcb/spvecgf2.h>
 #include <LEP/mcb/count_ptr.h>
 #include <LEP/mcb/udijkstra.h>
+#include <LEP/mcb/threads.h>
+#include <LEP/mcb/isometric.h>
 
 #ifdef LEDA_GE_V5
 #include <LEDA/graph/graph.h>
 #include <LEDA/graph/edge_array.h>
 #include <LEDA/graph/node_array.h>
-#include <LEDA/core/map.h>
 #include <LEDA/core/array.h>
-#include <LEDA/core/list.h>
 #include <LEDA/core/d_int_set.h>
 #else
 #include <LEDA/graph.h>
 #include <LEDA/edge_array.h>
 #include <LEDA/node_array.h>
-#include <LEDA/map.h>
 #include <LEDA/array.h>
-#include <LEDA/list.h>
 #include <LEDA/d_int_set.h>
 #endif
 
 #include <vector>
+#include <list>
 #include <algorithm>
 
 // start our namespace
@@ -79,7 +78,6 @@ namespace mcb
     using leda::edge_array;
     using leda::node;
     using leda::node_array;
-    using leda::list;
     using leda::error_handler;
     using leda::d_int_set;
 #endif
@@ -87,29 +85,29 @@ namespace mcb
     template<class W, class T> class TreeNode;
     template<class W, class T> class ShortestPathTree;
 
+    /*! A node of a shortest path tree. The nodes of a tree are stored in one 
+     *  array and the children are linked by their positions in it.
+     */
     template<class W, class T>
         class TreeNode {
             public:
-                TreeNode() : length_( W() ), info_( T() ) {}
-
-                ~TreeNode() {}
-
-                void add_child( TreeNode<W,T>* c ) { 
-                    children_.push_back( c ); 
-                }
-
-                list< TreeNode<W,T>* >& children() { 
-                    return children_; 
-                }
+                TreeNode() : length_( W() ), info_( T() ), pred_( nil ), 
+                    first_child_( -1 ), next_sibling_( -1 ) {}
 
                 T& info() { return info_; }
 
                 W& length() { return length_; }
 
+                edge pred() const { return pred_; }
+
             private: 
                 W length_;
                 T info_;
-                list< TreeNode<W, T>* > children_;
+                edge pred_;
+                int first_child_;
+                int next_sibling_;
+
+                friend class ShortestPathTree<W,T>;
         };
 
     template<class W, class T>
@@ -121,44 +119,46 @@ namespace mcb
                          const edge_array<W>& length,
                          const node_array<edge>& pred 
                        )
-                    : G(g), S(s), len(length), root(nil), map(G,nil), pr(nil) 
+                    : G(g), S(s), len(length)
                 {
                     initialize( pred );
                 }
 
-                ~ShortestPathTree() 
-                {
-                    node v; 
-                    forall_nodes( v, G ) 
-                        if ( map[v] != nil ) 
-                            delete map[v];
-                }
+                ~ShortestPathTree() {}
 
                 bool empty() const { 
-                    return root == nil; 
+                    return nodes.empty(); 
                 }
 
                 /*! \brief Get the shortest path tree node of a graph node. 
                  */
                 TreeNode<W,T>* get_TreeNode( node v ) const
                 {
-                    return map[ v ];
+                    int i = pos[ G.index( v ) ];
+                    return ( i < 0 ) ? nil : const_cast< TreeNode<W,T>* >( &nodes[i] );
                 }
 
-                // DEBUG DEBUG
-                node get_node( TreeNode<W,T>* v ) const { return map_debug[ v ]; }
-
                 TreeNode<W,T>* getRoot() const { 
-                    return root; 
+                    return get_TreeNode( S );
+                }
+
+                /*! Get the first child of a tree node, or nil.
+                 */
+                TreeNode<W,T>* first_child( TreeNode<W,T>* v ) const { 
+                    return at( v->first_child_ );
+                }
+
+                /*! Get the next child of the parent of a tree node, or nil.
+                 */
+                TreeNode<W,T>* next_sibling( TreeNode<W,T>* v ) const { 
+                    return at( v->next_sibling_ );
                 }
 
                 /*! Get the predecessor edge of a graph node 
                  *  in the shortest path tree 
                  */
                 edge get_pred( TreeNode<W,T>* v ) const {
-                    if ( pr.defined( v ) == false ) 
-                        return nil;
-                    return pr[v]; 
+                    return v->pred();
                 }
 
                 /*! Compute the length of the cycle consisting
@@ -182,30 +182,36 @@ namespace mcb
                 ShortestPathTree( const ShortestPathTree<W,T>& ); 
                 ShortestPathTree<W,T>& operator=( const ShortestPathTree<W,T>& );
 
-                void CreateNodeMap( const node_array<edge>& pred )
+                TreeNode<W,T>* at( int i ) const { 
+                    return ( i < 0 ) ? nil : const_cast< TreeNode<W,T>* >( &nodes[i] );
+                }
+
+                // one tree node for each visited graph node, in the order of the graph
+                void CreateNodeMap( const node_array<edge>& pred, std::vector<node>& visited )
                 {
                     node v;
 
-                    forall_nodes( v, G ) {
-                        if ( v == S || pred[v] != nil ) { // was visited
-                            map[ v ] = new TreeNode<W,T>();
-                            map_debug[ map[v] ] = v; // DEBUG DEBUG
-                            pr[ map[v] ] = pred[ v ];
-                        }
-                    }    
+                    forall_nodes( v, G ) 
+                        if ( v == S || pred[v] != nil ) // was visited
+                            visited.push_back( v );
+
+                    pos.assign( G.max_node_index() + 1, -1 );
+                    nodes.resize( visited.size() );
+                    for( int i = 0; i < (int) visited.size(); ++i ) { 
+                        pos[ G.index( visited[i] ) ] = i;
+                        nodes[i].pred_ = pred[ visited[i] ];
+                    }
                 }
 
-                void LinkTree( const node_array<edge>& pred )
+                // link in reverse order, thus the children are in the order of the graph
+                void LinkTree( const std::vector<node>& visited )
                 {
-                    node v;
-    
-                    forall_nodes( v, G ) { 
-                        if ( pred[ v ] != nil ) { // was visited 
-                            map[ G.opposite( pred[v], v ) ]->add_child( map[ v ] );
-                        }
-                        else if ( v == S ) { 
-                            root = map[v]; 
-                        } 
+                    for( int i = (int) visited.size() - 1; i >= 0; --i ) { 
+                        edge e = nodes[i].pred_;
+                        if ( e == nil ) continue;
+                        TreeNode<W,T>& p = nodes[ pos[ G.index( G.opposite( e, visited[i] ) ) ] ];
+                        nodes[i].next_sibling_ = p.first_child_;
+                        p.first_child_ = i;
                     }
                 }
 
@@ -219,24 +225,15 @@ namespace mcb
                     if ( r == nil ) return;
                     r->length() = W();
 
-                    // init list, add root
-                    list< TreeNode< W,T >* > l;
-                    l.push_back( r );
-
-                    // traverse and update lengths
-                    TreeNode< W,T > *p, *c;
-                    edge e = nil;
-                    while( l.empty() == false ) 
-                    {
-                        p = l.pop_front();
-
-                        leda::list_item li = p->children().first();
-                        while( li != nil ) {
-                            c = p->children().contents( li );
-                            e = get_pred( c );
-                            c->length() = p->length() + len[e];
-                            l.push_back(c);
-                            li = p->children().succ( li );
+                    // traverse in breadth first order and update lengths
+                    std::vector<int> l;
+                    l.reserve( nodes.size() );
+                    l.push_back( pos[ G.index( S ) ] );
+                    for( size_t h = 0; h < l.size(); ++h ) { 
+                        const TreeNode<W,T>& p = nodes[ l[h] ];
+                        for( int c = p.first_child_; c >= 0; c = nodes[c].next_sibling_ ) { 
+                            nodes[c].length_ = p.length_ + len[ nodes[c].pred_ ];
+                            l.push_back( c );
                         }
                     }
                 }
@@ -244,8 +241,9 @@ namespace mcb
 
                 void initialize( const node_array<edge>& pred ) 
                 { 
-                    CreateNodeMap( pred );
-                    LinkTree( pred );
+                    std::vector<node> visited;
+                    CreateNodeMap( pred, visited );
+                    LinkTree( visited );
                     ComputeLengths();
                 }
 
@@ -254,10 +252,8 @@ namespace mcb
                 const node S;
                 const edge_array<W>& len;
 
-                TreeNode<W,T> *root;
-                node_array< TreeNode<W,T>* > map;
-                leda::map< TreeNode<W,T>*, edge > pr;
-                leda::map< TreeNode<W,T>*, node > map_debug;  // DEBUG DEBUG
+                std::vector< TreeNode<W,T> > nodes;     // the tree nodes
+                std::vector<int> pos;                   // position of each graph node, -1 if not visited
         };
 
 
@@ -270,7 +266,7 @@ namespace mcb
 
                 node getNode() const { return v; }
                 edge getEdge() const { return e; }
-                W&   getLength() const { return len; }
+                const W& getLength() const { return len; }
 
                 bool operator<( const CandidateCycle<W>& c ) const { return len < c.len; }
 
@@ -285,11 +281,15 @@ namespace mcb
     class HortonSupersetTrees
     {
         public:
+            // Without build the trees and the cycles are left to the derived class.
             HortonSupersetTrees( const graph& g_, 
-                                 const edge_array<W>& len_ )
-                : g(g_), len(len_)
+                                 const edge_array<W>& len_, 
+                                 int threads_ = 1, 
+                                 bool build = true )
+                : g(g_), len(len_), threads( detail::num_threads( threads_ ) )
             {
-                computeTreesAndCycles();
+                if ( build ) 
+                    computeTreesAndCycles();
             }
 
             virtual ~HortonSupersetTrees() {}
@@ -299,135 +299,479 @@ namespace mcb
             HortonSupersetTrees& operator=( const HortonSupersetTrees& );
             
 
+            // The trees and the candidate cycles of each vertex are computed in 
+            // parallel. The cycles are merged in the order of the vertices, 
+            // thus the result is independent of the number of threads.
             void computeTreesAndCycles() { 
-                node v,u; 
-                edge e;
-                node_array<W> dist( g );
-                node_array<edge> pred( g );
+                node v;
+                std::vector<node> roots;
+                forall_nodes( v, g ) 
+                    roots.push_back( v );
+                int N = (int) roots.size();
+
+                // allocate outside the parallel region
                 trees.init( g );
-                edge_array<bool> used( g, false );
+                array< node_array<W> > dist( threads );
+                array< node_array<edge> > pred( threads );
+                array< edge_array<bool> > used( threads );
+                for( int t = 0; t < threads; ++t ) { 
+                    dist[t].init( g );
+                    pred[t].init( g, nil );
+                    used[t].init( g, false );
+                }
+                detail::ordered_buffers< CandidateCycle<W> > out( threads, N );
 
-                forall_nodes( v, g ) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(dynamic,1) if(threads > 1)
+#endif
+                for( int r = 0; r < N; ++r ) { 
+                    int t = detail::thread_num();
+                    node v = roots[r], u;
+                    edge e;
 
-                    pred.init( g, nil );
-                    mcb::undirected_dijkstra( g, v, len, dist, pred );
+                    mcb::undirected_dijkstra( g, v, len, dist[t], pred[t] );
 
                     //std::cout << "making tree for vertex " << vname[ v ] << std::endl;
-                    trees[ v ] = count_ptr< ShortestPathTree<W,T> >( new ShortestPathTree<W,T>( g, v, len, pred ) );
+                    trees[ v ] = count_ptr< ShortestPathTree<W,T> >( new ShortestPathTree<W,T>( g, v, len, pred[t] ) );
 
                     forall_nodes( u , g )
-                        if ( pred[u] != nil )
-                            used[ pred[u] ] = true;
+                        if ( pred[t][u] != nil )
+                            used[t][ pred[t][u] ] = true;
 
+                    std::vector< CandidateCycle<W> >& cyc = out.begin( r );
                     forall_edges( e, g ) 
-                        if ( used[ e ] == false && 
+                        if ( used[t][ e ] == false && 
                              trees[v]->get_TreeNode( g.source(e) ) != nil &&
                              trees[v]->get_TreeNode( g.target(e) ) != nil ) 
                         { 
-                            cycles.push_back( CandidateCycle<W>( v, e, trees[v]->ComputeCycleLength( e ) ) );
+                            cyc.push_back( CandidateCycle<W>( v, e, trees[v]->ComputeCycleLength( e ) ) );
                         }
+                    out.end( r );
 
                     forall_nodes( u , g ) 
-                        if ( pred[u] != nil ) 
-                            used[ pred[u] ] = false;
+                        if ( pred[t][u] != nil ) 
+                            used[t][ pred[t][u] ] = false;
                 }
+                out.merge( cycles );
                 std::sort( cycles.begin(), cycles.end() );
             }
 
         protected:
             const graph& g;
             const edge_array<W>& len;
+            int threads;
             node_array< count_ptr< ShortestPathTree<W,T> > > trees;
             std::vector< CandidateCycle<W> > cycles;
     };
 
+    namespace detail { 
+
+        /* A shortest path tree flattened in preorder. Position 0 is the root, 
+         * every other node is stored after its parent. The label of a node is 
+         * the parity of the intersection of its path to the root with a support
+         * vector, thus all labels are computed by one prefix-XOR pass.
+         */
+        struct preorder_tree 
+        { 
+            std::vector<int> parent;    // position of the parent, -1 for the root
+            std::vector<int> edge;      // number of the edge to the parent, -1 for the root
+            std::vector<char> label;
+            int version;                // phase of the support vector of the labels
+
+            preorder_tree() : version( -1 ) {}
+
+            template<class Set>
+                void update_labels( const Set& support ) { 
+                    int n = (int) parent.size();
+                    if ( n == 0 ) return;
+                    char *l = &label[0];
+                    const int *p = &parent[0], *e = &edge[0];
+                    l[0] = 0;
+                    for( int i = 1; i < n; ++i ) 
+                        l[i] = l[ p[i] ] ^ ( support.member( e[i] ) ? 1 : 0 );
+                }
+        };
+
+        /* A set of edge numbers as a bitmap, for read-only membership queries 
+         * from many threads. Assigning a new set clears only the previous members.
+         */
+        struct edge_bitmap 
+        { 
+            std::vector<char> bit;
+            std::vector<int> members;
+
+            void init( int m ) { bit.assign( m, 0 ); }
+
+            void assign( const spvecgf2& S ) { 
+                for( size_t i = 0; i < members.size(); ++i ) 
+                    bit[ members[i] ] = 0;
+                members.clear();
+                int j;
+                forall( j, S ) { 
+                    bit[ j ] = 1;
+                    members.push_back( j );
+                }
+            }
+
+            void assign( const d_int_set& S ) { 
+                for( size_t i = 0; i < members.size(); ++i ) 
+                    bit[ members[i] ] = 0;
+                members.clear();
+                for( int j = 0; j < (int) bit.size(); ++j ) 
+                    if ( S.member( j ) ) { 
+                        bit[ j ] = 1;
+                        members.push_back( j );
+                    }
+            }
+
+            bool member( int i ) const { return bit[ i ] != 0; }
+        };
+
+        /* A candidate cycle of the FH superset, packed for the odd-cycle scan.
+         * The endpoints of the edge are given by their positions in the 
+         * flattened tree of the root.
+         */
+        template<class W>
+            struct fh_candidate 
+            { 
+                W len;
+                int root;       // node index of the root
+                int src, tgt;   // positions of the endpoints in the tree of the root
+                int e;          // edge number, -1 when removed
+
+                fh_candidate( W l, int r, int s, int t, int e_ ) 
+                    : len(l), root(r), src(s), tgt(t), e(e_) {}
+
+                bool operator<( const fh_candidate<W>& c ) const { return len < c.len; }
+            };
+
+    } // namespace detail end
+
     /************************** UNDIRECTED GRAPHS ***************************/
 
+    // The info of each tree node is its position in the flattened tree.
     template<class W>
-    class UndirectedHortonSupersetTrees: public HortonSupersetTrees<W,bool>
+    class UndirectedHortonSupersetTrees: public HortonSupersetTrees<W,int>
     {
         public: 
-            typedef HortonSupersetTrees<W,bool> base_type;
+            typedef HortonSupersetTrees<W,int> base_type;
 
             UndirectedHortonSupersetTrees( const graph& g_, 
                                            const edge_array<W>& len_, 
-                                           const edge_num& enumb_ )
-                : base_type( g_, len_ ), enumb(enumb_) 
+                                           const edge_num& enumb_, 
+                                           int threads_ = 1, 
+                                           size_t memory_ = 0 )
+                : base_type( g_, len_, threads_, memory_ == 0 ), enumb(enumb_), first(0), 
+                mark( g_.number_of_edges(), 0 ), stamp(0), phase(0), 
+                memory(memory_), resident(0), block(0), hits(0), misses(0), evictions(0)
             { 
+                support.init( g_.number_of_edges() );
+                if ( memory > 0 ) { 
+                    initTreeCache();
+                    buildCandidates();
+                    return;
+                }
+
+                flattenTrees();
+                packCandidates();
+#ifndef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+                filterCandidates();
+#endif
+                // only the flattened trees are used from now on
+                trees.init( g );
+            }
+
+            ~UndirectedHortonSupersetTrees() 
+            {
+#ifdef LEP_STATS
+                if ( memory > 0 ) 
+                    std::cout << "LEP_STATS: FH trees: " << hits << " hits, " << misses 
+                        << " misses (recomputed), " << evictions << " evictions" << std::endl;
+#endif
             }
 
-            ~UndirectedHortonSupersetTrees() {}
+            /*! The number of times a resident tree was needed. */
+            size_t tree_hits() const { return hits; }
 
-            void updateTreeLabels( const d_int_set& support ) 
+            /*! The number of times an evicted tree was needed and recomputed. */
+            size_t tree_misses() const { return misses; }
+
+            /*! The number of times a tree was evicted. */
+            size_t tree_evictions() const { return evictions; }
+
+            /*! Set the support vector of a new phase. The labels of a tree 
+             *  are computed when the scan for the shortest odd cycle first 
+             *  reaches a candidate of its root, thus a phase which ends early 
+             *  labels only a few trees.
+             */
+            void updateTreeLabels( const d_int_set& S ) 
             { 
-                node v;
-                forall_nodes( v, g ) 
-                    updateTreeLabels( v, support );
+                support.assign( S );
+                ++phase;
             }
 
-            void updateTreeLabels( const spvecgf2& support ) 
+            void updateTreeLabels( const spvecgf2& S ) 
             { 
-                updateTreeLabels( support.to_d_int_set() );
+                support.assign( S );
+                ++phase;
             }
 
+            /*! Find the shortest cycle with odd intersection with the support 
+             *  vector S, which must have been set by updateTreeLabels().
+             */
             W getShortestOddCycle( const spvecgf2& S, spvecgf2& C ) 
             {
-                return getShortestOddCycle( S.to_d_int_set(), C ); 
+                return shortestOddCycle( C ); 
             }
 
         private:
             UndirectedHortonSupersetTrees( const UndirectedHortonSupersetTrees& );
             UndirectedHortonSupersetTrees& operator=( const UndirectedHortonSupersetTrees& );
 
-            W getShortestOddCycle( const d_int_set& support, spvecgf2& C ) 
-            {
-                node v; 
-                edge e;
-                bool label;
-                W min = W();
-                int min_index = -1;
+            typedef detail::fh_candidate<W> candidate_type;
 
-                TreeNode<W,bool> *eu, *ew;
-                for( unsigned int i = 0; i < cycles.size(); i++ ) 
-                {
-                    v = cycles[i].getNode();
-                    e = cycles[i].getEdge();
+            // Label the trees of the candidates [lo,hi) which are not labelled 
+            // in this phase. The trees are independent, thus they are labelled
+            // in parallel. Not worth it for less than 16K tree nodes.
+            // With a memory bound the evicted trees are recomputed first.
+            void labelTrees( size_t lo, size_t hi ) 
+            { 
+                stale.clear();
+                size_t nodes = 0;
+                ++block;
+                for( size_t i = lo; i < hi; ++i ) { 
+                    if ( cand[i].e < 0 ) 
+                        continue;
+                    int r = cand[i].root;
+                    detail::preorder_tree& f = flat[ r ];
+                    if ( memory > 0 ) 
+                        useTree( r );
+                    if ( f.version != phase ) { 
+                        f.version = phase;
+                        stale.push_back( r );
+                        nodes += tree_size[ r ];
+                    }
+                }
 
-                    eu = trees[v]->get_TreeNode( g.source(e) );
-                    ew = trees[v]->get_TreeNode( g.target(e) );
+                int N = (int) stale.size();
+                int T = ( nodes < 16384 ) ? 1 : threads;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(T) schedule(dynamic,1) if(T > 1)
+#else
+                (void) T;
+#endif
+                for( int i = 0; i < N; ++i ) { 
+                    if ( flat[ stale[i] ].parent.empty() ) 
+                        recomputeTree( stale[i], detail::thread_num() );
+                    flat[ stale[i] ].update_labels( support );
+                }
 
-#if ! defined(LEDA_CHECKING_OFF)
-                    if ( eu == nil || ew == nil ) 
-                        continue;
+                if ( memory > 0 ) { 
+                    for( int i = 0; i < N; ++i ) 
+                        if ( lru_pos[ stale[i] ] == lru.end() ) 
+                            addTree( stale[i] );
+                    evictTrees();
+                }
+            }
+
+            /*********************** memory bounded trees ************************/
+
+            // The trees are kept in least recently used order. The trees used by
+            // the current block are pinned and never evicted, thus the bound might 
+            // be exceeded for a single block. No tree is resident at the start, 
+            // each one is recomputed when a block first reaches it.
+
+            size_t treeBytes( int r ) const { 
+                return (size_t) tree_size[ r ] * ( 2 * sizeof(int) + sizeof(char) );
+            }
+
+            void initTreeCache() 
+            { 
+                int n = g.max_node_index() + 1;
+                lru_pos.assign( n, lru.end() );
+                pinned.assign( n, -1 );
+                sp_dist.resize( threads );
+                sp_pred.resize( threads );
+                for( int t = 0; t < threads; ++t ) { 
+                    sp_dist[t].init( g );
+                    sp_pred[t].init( g, nil );
+                }
+            }
+
+            // Build the candidates root by root. The tree of a root is flattened, 
+            // its candidates are extracted and it is dropped right away, thus at 
+            // most one tree per thread exists at any time. The isometric filter 
+            // needs the distances between all pairs of nodes and is not applied, 
+            // the superset is valid without it. The candidates are merged in the 
+            // order of the roots, independently of the number of threads.
+            void buildCandidates() 
+            { 
+                node v;
+                std::vector<node> roots;
+                forall_nodes( v, g ) 
+                    roots.push_back( v );
+                int N = (int) roots.size();
+
+                flat.resize( g.max_node_index() + 1 );
+                tree_size.assign( flat.size(), 0 );
+                root_node.assign( flat.size(), nil );
+                array< edge_array<bool> > used( threads );
+                for( int t = 0; t < threads; ++t ) 
+                    used[t].init( g, false );
+                detail::ordered_buffers< candidate_type > out( threads, N );
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(dynamic,1) if(threads > 1)
 #endif
-                    label = eu->info() ^ ew->info() ^ support.member( enumb(e) );
+                for( int r = 0; r < N; ++r ) { 
+                    int t = detail::thread_num();
+                    node v = roots[r], u;
+                    edge e;
+                    int ri = g.index( v );
+
+                    mcb::undirected_dijkstra( g, v, len, sp_dist[t], sp_pred[t] );
+                    ShortestPathTree<W,int> tree( g, v, len, sp_pred[t] );
+                    root_node[ ri ] = v;
+                    flattenTree( tree, flat[ ri ] );
+                    tree_size[ ri ] = (int) flat[ ri ].parent.size();
 
-                    if ( label ) { 
-                        min = eu->length() + ew->length() + len[e];
-                        min_index = i;
-                        break;
+                    forall_nodes( u , g )
+                        if ( sp_pred[t][u] != nil )
+                            used[t][ sp_pred[t][u] ] = true;
+
+                    std::vector< candidate_type >& cyc = out.begin( r );
+                    forall_edges( e, g ) { 
+                        TreeNode<W,int>* a = tree.get_TreeNode( g.source(e) );
+                        TreeNode<W,int>* b = tree.get_TreeNode( g.target(e) );
+                        if ( used[t][ e ] == false && a != nil && b != nil ) 
+                            cyc.push_back( candidate_type( tree.ComputeCycleLength( e ), ri, 
+                                        a->info(), b->info(), enumb( e ) ) );
                     }
+                    out.end( r );
+
+                    forall_nodes( u , g ) 
+                        if ( sp_pred[t][u] != nil ) 
+                            used[t][ sp_pred[t][u] ] = false;
+                    dropTree( ri );
                 }
+                out.merge( cand );
+                std::stable_sort( cand.begin(), cand.end() );
+#ifdef LEP_STATS
+                std::cout << "LEP_STATS: Horton superset: " << cand.size() 
+                    << " candidates, not filtered" << std::endl;
+#endif
+            }
 
-                if ( min_index < 0 ) 
-                    error_handler(999,"HF_MCB: no cycle found, this might be a bug!");
+            // mark a tree as used by the current block
+            void useTree( int r ) 
+            { 
+                if ( pinned[ r ] == block ) 
+                    return;
+                pinned[ r ] = block;
+                if ( lru_pos[ r ] != lru.end() ) { 
+                    ++hits;
+                    lru.splice( lru.begin(), lru, lru_pos[ r ] );
+                }
+                else 
+                    ++misses;
+            }
 
-                constructCycleUndirected( cycles[min_index], C); 
+            // make sure that a tree is resident, outside of the block scan
+            void loadTree( int r ) 
+            { 
+                useTree( r );
+                if ( lru_pos[ r ] == lru.end() ) { 
+                    recomputeTree( r, 0 );
+                    addTree( r );
+                    evictTrees();
+                }
+            }
 
-                return min;
+            void addTree( int r ) 
+            { 
+                lru.push_front( r );
+                lru_pos[ r ] = lru.begin();
+                resident += treeBytes( r );
             }
 
+            void evictTrees() 
+            { 
+                while( resident > memory && ! lru.empty() && pinned[ lru.back() ] != block ) { 
+                    int r = lru.back();
+                    lru.pop_back();
+                    lru_pos[ r ] = lru.end();
+                    resident -= treeBytes( r );
+                    dropTree( r );
+                    ++evictions;
+                }
+            }
+
+            void dropTree( int r ) 
+            { 
+                detail::preorder_tree& f = flat[ r ];
+                std::vector<int>().swap( f.parent );
+                std::vector<int>().swap( f.edge );
+                std::vector<char>().swap( f.label );
+                f.version = -1;
+            }
 
-            void constructCycleUndirected( const CandidateCycle<W>& cc, spvecgf2& C ) 
+            // Recompute an evicted tree by Dijkstra, using the arrays of thread t.
+            // The shortest paths are the same, thus so are the positions.
+            void recomputeTree( int r, int t ) 
+            { 
+                node v = root_node[ r ];
+                mcb::undirected_dijkstra( g, v, len, sp_dist[t], sp_pred[t] );
+                ShortestPathTree<W,int> tree( g, v, len, sp_pred[t] );
+                flattenTree( tree, flat[ r ] );
+            }
+
+            // Scan the candidates in increasing length, starting from the first 
+            // one not removed. The candidates are scanned in blocks, labelling 
+            // first the trees reached by a block. The chosen cycle is orthogonal 
+            // to all later support vectors, thus it is removed together with all 
+            // its copies from other roots.
+            W shortestOddCycle( spvecgf2& C ) 
+            {
+                while( first < cand.size() && cand[first].e < 0 ) 
+                    ++first;
+
+                const size_t block = 256;
+                size_t i = first, end = first;
+                for( ; i < cand.size(); ++i ) 
+                { 
+                    if ( i == end ) { 
+                        end = std::min( i + block, cand.size() );
+                        labelTrees( i, end );
+                    }
+                    const candidate_type& c = cand[i];
+                    if ( c.e < 0 ) 
+                        continue;
+                    const char *l = &flat[ c.root ].label[0];
+                    if ( l[ c.src ] ^ l[ c.tgt ] ^ ( support.member( c.e ) ? 1 : 0 ) ) 
+                        break;
+                }
+
+                if ( i == cand.size() ) { 
+                    error_handler(999,"HF_MCB: no cycle found, this might be a bug!");
+                    return W();
+                }
+
+                W min = cand[i].len;
+                constructCycleUndirected( cand[i], C ); 
+                removeCopies( i, C );
+                return min;
+            }
+
+            void constructCycleUndirected( const candidate_type& cc, spvecgf2& C ) 
             {
                 spvecgf2 C1;
-                constructPathUndirected( cc.getNode(), g.source( cc.getEdge() ), C1 ); 
+                constructPathUndirected( cc.root, cc.src, C1 ); 
 
                 spvecgf2 C2;
-                constructPathUndirected( cc.getNode(), g.target( cc.getEdge() ), C2 );
+                constructPathUndirected( cc.root, cc.tgt, C2 );
 
                 C.clear();
-                C.insert( enumb( cc.getEdge() ) );
+                C.insert( cc.e );
 
                 // NOTE: If the graph has edges with zero length, paths C1,C2 might 
                 //       contain common edges. The following addition will eliminate them.
@@ -435,53 +779,262 @@ namespace mcb
                 C += C2;
             }
 
-            // construct path from v to root in trees[root]
-            void constructPathUndirected( node root, node v, spvecgf2& C ) 
+            // construct path from position i to the root in the tree of root
+            void constructPathUndirected( int root, int i, spvecgf2& C ) 
             {
-                edge e; 
-                node u = v; 
-                e = trees[root]->get_pred( trees[root]->get_TreeNode( u ) );
-                while( e != nil ) {
-                    C.insert( enumb( e ) );
-                    u = g.opposite( u, e );
-                    e = trees[root]->get_pred( trees[root]->get_TreeNode( u ) );
-                }
+                const detail::preorder_tree& f = flat[ root ];
+                for( ; f.parent[i] >= 0; i = f.parent[i] ) 
+                    C.insert( f.edge[i] );
                 C.sort();
             }
 
-            void updateTreeLabels( node v, const d_int_set& support ) { 
-                // fix root's info
-                TreeNode< W, bool >* r = trees[v]->getRoot(); 
-                if ( r == nil ) return;
-                r->info() = false;
+            // Remove candidate i and every candidate with the same cycle C. Copies 
+            // have the same length, thus they are adjacent to i in the order.
+            void removeCopies( size_t i, const spvecgf2& C ) 
+            { 
+                int j;
+                ++stamp;
+                forall( j, C ) 
+                    mark[ j ] = stamp;
+
+                size_t lo = i, hi = i + 1;
+                while( lo > first && ! ( cand[lo-1].len < cand[i].len ) ) 
+                    --lo;
+                while( hi < cand.size() && ! ( cand[i].len < cand[hi].len ) ) 
+                    ++hi;
+
+                for( size_t k = lo; k < hi; ++k ) 
+                    if ( k != i && cand[k].e >= 0 && mark[ cand[k].e ] == stamp ) { 
+                        if ( memory > 0 ) 
+                            loadTree( cand[k].root );
+                        if ( isCycle( cand[k], C.size() ) ) 
+                            cand[k].e = -1;
+                    }
+                cand[i].e = -1;
+            }
 
-                // init list, add root
-                list< TreeNode< W, bool >* > l;
-                l.push_back( r );
+            // check if a candidate consists of exactly the marked edges, 
+            // these are size many
+            bool isCycle( const candidate_type& c, int size ) 
+            { 
+                int count = 1;
+                int ends[2] = { c.src, c.tgt };
+                const detail::preorder_tree& f = flat[ c.root ];
+                for( int p = 0; p < 2; ++p ) 
+                    for( int i = ends[p]; f.parent[i] >= 0; i = f.parent[i] ) { 
+                        if ( mark[ f.edge[i] ] != stamp ) 
+                            return false;
+                        if ( ++count > size ) 
+                            return false;
+                    }
+                return count == size;
+            }
 
-                // traverse and update labels
-                TreeNode< W, bool > *p, *c;
-                edge e;
-                while( l.empty() == false ) 
-                {
-                    p = l.pop_front();
-
-                    leda::list_item li = p->children().first();
-                    while( li != nil ) {
-                        c = p->children().contents( li );
-                        e = trees[v]->get_pred( c );
-                        c->info() = p->info() ^ support.member( enumb(e) );
-                        l.push_back(c);
-                        li = p->children().succ( li );
+            // pack the candidates, in the same order
+            void packCandidates() 
+            { 
+                cand.reserve( cycles.size() );
+                for( size_t i = 0; i < cycles.size(); ++i ) { 
+                    node v = cycles[i].getNode();
+                    edge e = cycles[i].getEdge();
+                    cand.push_back( candidate_type( cycles[i].getLength(), g.index( v ), 
+                                trees[v]->get_TreeNode( g.source(e) )->info(), 
+                                trees[v]->get_TreeNode( g.target(e) )->info(), 
+                                enumb( e ) ) );
+                }
+                std::vector< CandidateCycle<W> >().swap( cycles );
+            }
+
+            // distances between node indices
+            struct distances 
+            { 
+                const std::vector<W>& d;
+                size_t n;
+                distances( const std::vector<W>& d_, int n_ ) : d(d_), n(n_) {}
+                W operator()( int a, int b ) const { return d[ a * n + b ]; }
+            };
+
+            // the edges of a candidate, in increasing order
+            void candidateEdges( const candidate_type& c, std::vector<int>& out ) const
+            { 
+                const detail::preorder_tree& f = flat[ c.root ];
+                out.assign( 1, c.e );
+                for( int i = c.src; f.parent[i] >= 0; i = f.parent[i] ) 
+                    out.push_back( f.edge[i] );
+                for( int i = c.tgt; f.parent[i] >= 0; i = f.parent[i] ) 
+                    out.push_back( f.edge[i] );
+                std::sort( out.begin(), out.end() );
+            }
+
+            // whether two candidates consist of the same edges
+            struct same_cycle 
+            { 
+                const UndirectedHortonSupersetTrees<W>& hs;
+                std::vector<int> a, b;
+                same_cycle( const UndirectedHortonSupersetTrees<W>& hs_ ) : hs(hs_) {}
+                bool operator()( const candidate_type& x, const candidate_type& y ) { 
+                    if ( x.len < y.len || y.len < x.len ) 
+                        return false;
+                    hs.candidateEdges( x, a );
+                    hs.candidateEdges( y, b );
+                    return a == b;
+                }
+            };
+
+            // per thread arrays used while filtering
+            struct scratch 
+            { 
+                std::vector<int> path[2], cv;   // vertices of the paths and the cycle
+                std::vector<W> plen[2], cl;     // and the lengths of their edges
+            };
+
+            // Remove the non-isometric candidates and the copies of the same 
+            // cycle from different roots, see isometric.h. Candidates whose 
+            // two paths share edges are not simple cycles and are kept.
+            void filterCandidates() 
+            { 
+                int n = g.max_node_index() + 1;
+                int N = (int) cand.size();
+                node v, u;
+
+                // distances and the node index of each tree position
+                std::vector<W> dist( (size_t) n * n, W() );
+                std::vector< std::vector<int> > vertex( flat.size() );
+                forall_nodes( v, g ) { 
+                    std::vector<int>& vx = vertex[ g.index( v ) ];
+                    vx.resize( flat[ g.index( v ) ].parent.size() );
+                    forall_nodes( u, g ) { 
+                        TreeNode<W,int>* p = trees[v]->get_TreeNode( u );
+                        if ( p == nil ) continue;
+                        dist[ (size_t) g.index( v ) * n + g.index( u ) ] = p->length();
+                        vx[ p->info() ] = g.index( u );
                     }
                 }
+
+                std::vector<char> keep( N, 1 );
+                std::vector<unsigned long> key( N, 0 );
+                std::vector< scratch > scr( threads );
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(dynamic,256) if(threads > 1)
+#endif
+                for( int c = 0; c < N; ++c ) { 
+                    scratch& s = scr[ detail::thread_num() ];
+                    const candidate_type& cc = cand[c];
+                    const detail::preorder_tree& f = flat[ cc.root ];
+                    const std::vector<int>& vx = vertex[ cc.root ];
+                    int ends[2] = { cc.src, cc.tgt };
+
+                    // walk both paths towards the root
+                    unsigned long k = detail::cycle_key( cc.e );
+                    for( int p = 0; p < 2; ++p ) { 
+                        s.path[p].assign( 1, vx[ ends[p] ] );
+                        s.plen[p].clear();
+                        for( int i = ends[p]; f.parent[i] >= 0; i = f.parent[i] ) { 
+                            k ^= detail::cycle_key( f.edge[i] );
+                            s.path[p].push_back( vx[ f.parent[i] ] );
+                            s.plen[p].push_back( len[ enumb( f.edge[i] ) ] );
+                        }
+                    }
+                    key[c] = k;
+
+                    // simple only if the paths leave the root by different edges
+                    size_t a = s.path[0].size(), b = s.path[1].size();
+                    if ( a > 1 && b > 1 && s.path[0][a-2] == s.path[1][b-2] ) 
+                        continue;
+
+                    // the cycle is root ... src, tgt ... root
+                    s.cv.assign( s.path[0].rbegin(), s.path[0].rend() );
+                    s.cl.assign( s.plen[0].rbegin(), s.plen[0].rend() );
+                    s.cl.push_back( len[ enumb( cc.e ) ] );
+                    s.cv.insert( s.cv.end(), s.path[1].begin(), s.path[1].end() - 1 );
+                    s.cl.insert( s.cl.end(), s.plen[1].begin(), s.plen[1].end() );
+                    if ( ! detail::is_isometric( s.cv, s.cl, distances( dist, n ) ) ) 
+                        keep[c] = 0;
+                }
+                std::vector<W>().swap( dist );
+
+                size_t out = 0;
+                for( int c = 0; c < N; ++c ) 
+                    if ( keep[c] ) { 
+                        cand[ out ] = cand[c];
+                        key[ out++ ] = key[c];
+                    }
+                cand.erase( cand.begin() + out, cand.end() );
+                key.resize( out );
+
+                same_cycle same( *this );
+#ifdef LEP_STATS
+                size_t copies = detail::remove_copies( cand, key, same );
+                std::cout << "LEP_STATS: Horton superset: " << N << " candidates, " 
+                    << N - out << " not isometric, " << copies << " copies, " 
+                    << cand.size() << " kept" << std::endl;
+#else
+                detail::remove_copies( cand, key, same );
+#endif
+            }
+
+            // flatten each tree in preorder, and store the positions in the tree nodes
+            void flattenTrees() 
+            { 
+                node v;
+                flat.resize( g.max_node_index() + 1 );
+                tree_size.assign( flat.size(), 0 );
+                root_node.assign( flat.size(), nil );
+                forall_nodes( v, g ) { 
+                    root_node[ g.index( v ) ] = v;
+                    flattenTree( *trees[v], flat[ g.index( v ) ] );
+                    tree_size[ g.index( v ) ] = (int) flat[ g.index( v ) ].parent.size();
+                }
+            }
+
+            void flattenTree( ShortestPathTree<W,int>& t, detail::preorder_tree& f ) const
+            { 
+                TreeNode<W,int>* r = t.getRoot();
+                if ( r == nil ) return;
+
+                std::vector< std::pair< TreeNode<W,int>*, int > > stack;
+                stack.push_back( std::make_pair( r, -1 ) );
+                while( ! stack.empty() ) { 
+                    TreeNode<W,int>* p = stack.back().first;
+                    p->info() = (int) f.parent.size();
+                    f.parent.push_back( stack.back().second );
+                    f.edge.push_back( ( p == r ) ? -1 : enumb( t.get_pred( p ) ) );
+                    stack.pop_back();
+
+                    for( TreeNode<W,int>* c = t.first_child( p ); c != nil; c = t.next_sibling( c ) ) 
+                        stack.push_back( std::make_pair( c, p->info() ) );
+                }
+                f.label.assign( f.parent.size(), 0 );
             }
 
             const edge_num& enumb;
+            std::vector< detail::preorder_tree > flat;     // indexed by node index of root
+            std::vector< candidate_type > cand;
+            size_t first;                                   // no candidate before is left
+            std::vector<int> mark;
+            int stamp;
+            detail::edge_bitmap support;                    // of the current phase
+            int phase;                                      // number of the current phase
+            std::vector<int> stale;                         // roots of trees to label
+            std::vector<int> tree_size;                     // number of nodes of each tree
+            std::vector<node> root_node;                    // node of each node index
+
+            // memory bounded trees
+            size_t memory;                                  // bound in bytes, 0 for none
+            size_t resident;                                // bytes of the resident trees
+            std::list<int> lru;                             // resident trees, most recent first
+            std::vector< std::list<int>::iterator > lru_pos;
+            std::vector<int> pinned;                        // last block using each tree
+            int block;
+            array< node_array<W> > sp_dist;                 // per thread, for recomputation
+            array< node_array<edge> > sp_pred;
+            size_t hits, misses, evictions;
             using base_type::g;
             using base_type::trees;
             using base_type::cycles;
             using base_type::len;
+            using base_type::threads;
     };
 
 }
@@ -32,6 +32,21 @@
 /*! \file superset.h
  *  \brief Builder constructs for Horton's Superset
  *
+ *  The superset is kept in compact form. Each candidate cycle stores only its
+ *  root vertex, its non-tree edge, its length and its number of edges. The
+ *  edges of a candidate are reconstructed on demand from the shortest path 
+ *  trees, which are stored as one flat matrix of edge numbers, and kept in a 
+ *  contiguous pool once scanned.
+ *
+ *  The memory is still quadratic in the number of vertices. The matrix of 
+ *  predecessor edges has \f$n^2\f$ integers and is kept for the whole 
+ *  computation. While constructing, the isometric filter also keeps an 
+ *  \f$n \times n\f$ matrix of distances, since it queries the distance between 
+ *  any two vertices of a candidate. The matrix is released after the 
+ *  construction and is not allocated when the filter is disabled, see 
+ *  isometric.h. Only the memory of the candidates themselves was reduced, from 
+ *  one edge set each to a few words each.
+ *
  *  \sa mcb::edge_num mcb::spvecgf2
  */
 
@@ -44,28 +59,24 @@
 #include <LEDA/graph/graph.h>
 #include <LEDA/graph/edge_array.h>
 #include <LEDA/graph/node_array.h>
-#include <LEDA/graph/node_set.h>
 #include <LEDA/core/d_int_set.h>
 #include <LEDA/core/array.h>
-#include <LEDA/core/list.h>
-#include <LEDA/core/sortseq.h>
-#include <LEDA/core/tuple.h>
 #include <LEDA/system/error.h>
 #else
 #include <LEDA/graph.h>
 #include <LEDA/d_int_set.h>
 #include <LEDA/edge_array.h>
 #include <LEDA/node_array.h>
-#include <LEDA/node_set.h>
 #include <LEDA/array.h>
-#include <LEDA/list.h>
-#include <LEDA/sortseq.h>
-#include <LEDA/tuple.h>
 #include <LEDA/error.h>
 #endif
 
+#include <vector>
+#include <algorithm>
 #include <LEP/mcb/edge_num.h>
 #include <LEP/mcb/udijkstra.h>
+#include <LEP/mcb/threads.h>
+#include <LEP/mcb/isometric.h>
 
 // start our namespace
 namespace mcb 
@@ -77,142 +88,340 @@ namespace mcb
     using leda::edge;
     using leda::edge_array;
     using leda::d_int_set;
-    using leda::list;
-    using leda::sortseq;
-    using leda::three_tuple;
-    using leda::two_tuple;
-    using leda::node_set;
 #endif
 
+    namespace detail { 
+
+        /* A candidate cycle of Horton's superset. The cycle consists of edge 
+         * e=(w,u) and the two shortest paths from the root to w and u. It is
+         * ordered by length, then by number of edges and then by creation.
+         */
+        template<class W>
+            struct horton_candidate
+            {
+                W len;
+                int size;
+                int root;   // node index of the root
+                int e;      // edge number, -1 when erased
+
+                horton_candidate() : len(W()), size(0), root(-1), e(-1) {}
+                horton_candidate( W l, int s, int r, int e_ ) : len(l), size(s), root(r), e(e_) {}
+
+                bool operator<( const horton_candidate<W>& c ) const { 
+                    return len < c.len || ( ! ( c.len < len ) && size < c.size ); 
+                }
+            };
+
+    } // namespace detail end
+
     template<class W>
         class HortonSupersetBuilder
         {
             public:
+                typedef detail::horton_candidate<W> candidate_type;
+
                 HortonSupersetBuilder( const graph& G_,
                         const edge_array<W>& len_, 
-                        const mcb::edge_num& enumb_ )
-                    : G(G_), len(len_), enumb(enumb_), pred(G_)
+                        const mcb::edge_num& enumb_, 
+                        int threads_ = 1 )
+                    : G(G_), len(len_), enumb(enumb_), 
+                    n( G_.max_node_index() + 1 ), threads( detail::num_threads( threads_ ) )
                 { 
                 }
 
-                void construct( sortseq< three_tuple<W,int,int>, d_int_set >& super )
+                /*! Construct the superset. The candidates are returned in 
+                 *  increasing order. The shortest path trees are kept by the 
+                 *  builder, they are needed to reconstruct the candidate cycles.
+                 *
+                 *  Both the shortest path trees and the candidates of each root
+                 *  are computed in parallel. The candidates are merged in the 
+                 *  order of the roots, thus the result is independent of the 
+                 *  number of threads. Non-isometric candidates and copies of 
+                 *  the same cycle are removed, see isometric.h.
+                 *
+                 *  Needs \f$n^2\f$ integers for the trees plus, with the 
+                 *  isometric filter, \f$n^2\f$ lengths for the distances.
+                 */
+                void construct( std::vector< candidate_type >& super )
                 {
-                    // initialize
-                    node v,w,u,vz,ezs,ezt; 
-                    edge e,ez;
+                    node v;
 
-                    int c = 0;
-                    node_array<int> degree(G,0);
-                    node_set touched( G );
-                    bool dege;
+                    std::vector<node> roots;
+                    nodes.assign( n, (node) nil );
+                    forall_nodes( v, G ) { 
+                        nodes[ G.index( v ) ] = v;
+                        roots.push_back( v );
+                    }
+                    int N = (int) roots.size();
 
-                    W min;
+                    ConstructPaths( roots );
 
-                    ConstructPaths();
-
-                    forall_nodes( v , G ) { 
-                        forall_edges( e, G ) { 
-
-                            dege = false;
-
-                            w = G.source(e);
-                            u = G.target(e);
-
-                            // valid?
-                            if ( v == w || v == u || 
-                                    pred[ v ][ w ] == nil || pred[ v ][ u ] == nil ||
-                                    pred[ v ][ w ] == e || pred[ v ][ u ] == e || 
-                                    pred[ w ][ v ] == e || pred[ u ][ v ] == e ) 
-                                continue;
-
-                            // try to construct cycle
-                            C.clear();
-
-                            // insert e
-                            C.insert( enumb(e) );
-                            ezs = G.source( e );
-                            ezt = G.target( e );
-                            degree[ ezs ]++;
-                            degree[ ezt ]++;
-                            touched.insert( ezs );
-                            touched.insert( ezt );
-
-                            min = len[ e ];
-
-                            // create two paths
-                            int en;
-                            node x,y; 
-
-                            // make sure path is unique
-                            if ( v->id() < w->id() ) { y = v; x = w; }
-                            else { y = w; x = v; }
-
-                            while( pred[ y ][ x ] != nil && dege == false ) {
-                                ez = pred[ y ][ x ];
-                                en = enumb( ez );
-                                if ( ! C.member( en ) ) {
-                                    C.insert( en );
-                                    ezs = G.source( ez );
-                                    ezt = G.target( ez );
-                                    degree[ ezs ]++;
-                                    degree[ ezt ]++;
-                                    if ( degree[ ezs ] > 2 || degree[ ezt ] > 2 )
-                                        dege = true;
-                                    touched.insert( ezs );
-                                    touched.insert( ezt );
-                                    min += len[ ez ];
-                                }
-                                x = G.opposite( ez, x );
-                            }
+                    detail::ordered_buffers< candidate_type > out( threads, N );
+                    detail::ordered_buffers< unsigned long > keys( threads, N );
+                    std::vector< scratch > scr( threads );
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(dynamic,1) if(threads > 1)
+#endif
+                    for( int r = 0; r < N; ++r ) { 
+                        scratch& s = scr[ detail::thread_num() ];
+                        s.init( n, G.number_of_edges() );
+                        ConstructCandidates( G.index( roots[r] ), s, out.begin( r ), keys.begin( r ) );
+                        out.end( r );
+                        keys.end( r );
+                    }
+                    std::vector<W>().swap( dist );
+
+                    super.clear();
+                    out.merge( super );
+
+#ifndef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+                    std::vector<unsigned long> key;
+                    keys.merge( key );
+                    same_cycle same( *this );
+#ifdef LEP_STATS
+                    size_t copies = detail::remove_copies( super, key, same );
+                    size_t skipped = 0;
+                    for( int t = 0; t < threads; ++t ) 
+                        skipped += scr[t].non_isometric;
+                    std::cout << "LEP_STATS: Horton superset: " << super.size() + copies + skipped 
+                        << " candidates, " << skipped << " not isometric, " << copies 
+                        << " copies, " << super.size() << " kept" << std::endl;
+#else
+                    detail::remove_copies( super, key, same );
+#endif
+#endif
+
+                    // stable, ties are broken by creation order
+                    std::stable_sort( super.begin(), super.end() );
+                }
+
+                /*! Reconstruct the edges of a candidate cycle.
+                 *  \param c A candidate created by this builder.
+                 *  \return The edge numbers of the cycle.
+                 */
+                const std::vector<int>& cycle( const candidate_type& c ) 
+                {
+                    edges.clear();
+                    edges.push_back( c.e );
+
+                    edge e = enumb( c.e );
+                    int ends[2] = { G.index( G.source( e ) ), G.index( G.target( e ) ) };
+
+                    int ezn, xi, yi;
+                    node x;
+                    for( int p = 0; p < 2; ++p ) { 
+                        path_ends( c.root, ends[p], yi, xi );
+                        x = nodes[ xi ];
+                        while( ( ezn = pred( yi, xi ) ) >= 0 ) { 
+                            edges.push_back( ezn );
+                            x = G.opposite( enumb( ezn ), x );
+                            xi = G.index( x );
+                        }
+                    }
+                    return edges;
+                }
+
+            private:
+
+                // make sure path is unique, use the tree of the lower id endpoint
+                void path_ends( int vi, int wi, int& yi, int& xi ) const { 
+                    if ( nodes[ vi ]->id() < nodes[ wi ]->id() ) { yi = vi; xi = wi; }
+                    else { yi = wi; xi = vi; }
+                }
+
+                int pred( int y, int x ) const { 
+                    return tree[ (size_t) y * n + x ];
+                }
+
+                // per thread arrays used while creating the candidates
+                struct scratch 
+                { 
+                    std::vector<int> degree;
+                    std::vector<int> touched;
+                    std::vector<int> stamp;
+                    int c;
+                    std::vector<int> path[2], cv;   // vertices of the paths and the cycle
+                    std::vector<W> plen[2], cl;     // and the lengths of their edges
+                    size_t non_isometric;
+
+                    void init( int n, int m ) { 
+                        if ( degree.empty() ) { 
+                            degree.assign( n, 0 );
+                            stamp.assign( m, -1 );
+                            c = 0;
+                            non_isometric = 0;
+                        }
+                    }
+                };
+
+                // distances between node indices
+                struct distances 
+                { 
+                    const std::vector<W>& d;
+                    size_t n;
+                    distances( const std::vector<W>& d_, int n_ ) : d(d_), n(n_) {}
+                    W operator()( int a, int b ) const { return d[ a * n + b ]; }
+                };
+
+                // whether two candidates consist of the same edges
+                struct same_cycle 
+                { 
+                    HortonSupersetBuilder<W>& hs;
+                    std::vector<int> a;
+                    same_cycle( HortonSupersetBuilder<W>& hs_ ) : hs(hs_) {}
+                    bool operator()( const candidate_type& x, const candidate_type& y ) { 
+                        if ( x.len < y.len || y.len < x.len || x.size != y.size ) 
+                            return false;
+                        a = hs.cycle( x );
+                        const std::vector<int>& b = hs.cycle( y );
+                        std::sort( a.begin(), a.end() );
+                        std::sort( hs.edges.begin(), hs.edges.end() );
+                        return a == b;
+                    }
+                };
+
+                // create the candidates of a root
+                void ConstructCandidates( int vi, scratch& s, std::vector< candidate_type >& out, 
+                        std::vector< unsigned long >& keys ) 
+                { 
+                    node v = nodes[ vi ];
+                    node w,u;
+                    edge e;
+                    bool dege;
 
-                            if ( v->id() < u->id() ) { y = v; x = u; }
-                            else { y = u; x = v; }
-
-                            while( pred[ y ][ x ] != nil && dege == false ) {
-                                ez = pred[ y ][ x ];
-                                en = enumb( ez );
-                                if ( ! C.member( en ) ) {
-                                    C.insert( en );
-                                    ezs = G.source( ez );
-                                    ezt = G.target( ez );
-                                    degree[ ezs ]++;
-                                    degree[ ezt ]++;
-                                    if ( degree[ ezs ] > 2 || degree[ ezt ] > 2 )
+                    W min;
+                    int size;
+
+                    forall_edges( e, G ) { 
+
+                        dege = false;
+
+                        w = G.source(e);
+                        u = G.target(e);
+                        int en = enumb( e );
+                        int wi = G.index( w );
+                        int ui = G.index( u );
+
+                        // valid?
+                        if ( v == w || v == u || 
+                                pred( vi, wi ) < 0 || pred( vi, ui ) < 0 ||
+                                pred( vi, wi ) == en || pred( vi, ui ) == en || 
+                                pred( wi, vi ) == en || pred( ui, vi ) == en ) 
+                            continue;
+
+                        // try to construct cycle
+                        s.stamp[ en ] = s.c;
+                        s.degree[ wi ]++;
+                        s.degree[ ui ]++;
+                        s.touched.push_back( wi );
+                        s.touched.push_back( ui );
+                        min = len[ e ];
+                        size = 1;
+                        unsigned long key = detail::cycle_key( en );
+
+                        // create two paths
+                        edge ez;
+                        node x;
+                        int ezn, xi, yi, ezs, ezt;
+                        for( int p = 0; p < 2 && dege == false; ++p ) { 
+                            path_ends( vi, ( p == 0 ) ? wi : ui, yi, xi );
+                            x = nodes[ xi ];
+                            s.path[p].assign( 1, xi );
+                            s.plen[p].clear();
+
+                            while( ( ezn = pred( yi, xi ) ) >= 0 && dege == false ) {
+                                ez = enumb( ezn );
+                                if ( s.stamp[ ezn ] != s.c ) {
+                                    s.stamp[ ezn ] = s.c;
+                                    ezs = G.index( G.source( ez ) );
+                                    ezt = G.index( G.target( ez ) );
+                                    s.degree[ ezs ]++;
+                                    s.degree[ ezt ]++;
+                                    if ( s.degree[ ezs ] > 2 || s.degree[ ezt ] > 2 )
                                         dege = true;
-                                    touched.insert( ezs );
-                                    touched.insert( ezt );
+                                    s.touched.push_back( ezs );
+                                    s.touched.push_back( ezt );
                                     min += len[ ez ];
+                                    size++;
+                                    key ^= detail::cycle_key( ezn );
                                 }
                                 x = G.opposite( ez, x );
+                                xi = G.index( x );
+                                s.path[p].push_back( xi );
+                                s.plen[p].push_back( len[ ez ] );
                             }
 
-
-                            // init degree array, and check for degeneracy
-                            while( touched.empty() == false ) {
-                                vz = touched.choose();
-                                touched.del( vz );
-                                if ( degree[ vz ] == 1 ) dege = true;
-                                degree[ vz ] = 0;
+                            // orient from the root
+                            if ( yi == vi ) { 
+                                std::reverse( s.path[p].begin(), s.path[p].end() );
+                                std::reverse( s.plen[p].begin(), s.plen[p].end() );
                             }
+                        }
 
-                            if ( dege == true ) continue;
-
-                            // add cycle to superset
-                            three_tuple<W,int,int> tt( min, C.size(), c++ ); 
-                            super.insert( tt, C );
+                        // init degree array, and check for degeneracy
+                        for( size_t i = 0; i < s.touched.size(); ++i ) { 
+                            if ( s.degree[ s.touched[i] ] == 1 ) dege = true;
+                            s.degree[ s.touched[i] ] = 0;
+                        }
+                        s.touched.clear();
+
+                        s.c++;
+                        if ( dege == true ) continue;
+
+#ifndef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+                        // the cycle is v ... w, u ... v
+                        s.cv = s.path[0];
+                        s.cl = s.plen[0];
+                        s.cl.push_back( len[ e ] );
+                        s.cv.insert( s.cv.end(), s.path[1].rbegin(), s.path[1].rend() - 1 );
+                        s.cl.insert( s.cl.end(), s.plen[1].rbegin(), s.plen[1].rend() );
+                        if ( ! detail::is_isometric( s.cv, s.cl, distances( dist, n ) ) ) { 
+                            s.non_isometric++;
+                            continue;
                         }
+                        keys.push_back( key );
+#else
+                        (void) keys;
+#endif
+
+                        // add cycle to superset
+                        out.push_back( candidate_type( min, size, vi, en ) );
                     }
                 }
 
-            private:
+                // one shortest path tree per root, computed in parallel 
+                void ConstructPaths( const std::vector<node>& roots ) { 
+                    int N = (int) roots.size();
 
-                void ConstructPaths() { 
-                    node v;
-                    node_array<W> dist(G);
+                    // allocate outside the parallel region
+                    array< node_array<W> > d( threads );
+                    array< node_array<edge> > p( threads );
+                    for( int t = 0; t < threads; ++t ) { 
+                        d[t].init( G );
+                        p[t].init( G, nil );
+                    }
+
+                    tree.assign( (size_t) n * n, -1 );
+#ifndef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+                    dist.assign( (size_t) n * n, W() );
+#endif
 
-                    forall_nodes( v, G ) {
-                        pred[v].init( G, nil );
-                        mcb::undirected_dijkstra( G, v, len, dist, pred[v] );
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(dynamic,1) if(threads > 1)
+#endif
+                    for( int r = 0; r < N; ++r ) {
+                        int t = detail::thread_num();
+                        node u;
+                        mcb::undirected_dijkstra( G, roots[r], len, d[t], p[t] );
+                        size_t row = (size_t) G.index( roots[r] ) * n;
+                        forall_nodes( u, G ) { 
+                            if ( p[t][ u ] != nil ) 
+                                tree[ row + G.index( u ) ] = enumb( p[t][ u ] );
+#ifndef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+                            dist[ row + G.index( u ) ] = d[t][ u ];
+#endif
+                        }
                     }
                 }
 
@@ -223,49 +432,153 @@ namespace mcb
                 const graph& G;
                 const edge_array<W>& len;
                 const mcb::edge_num& enumb;
-                node_array< node_array<edge> > pred;
-                d_int_set C;
+                int n;
+                int threads;
+                std::vector<node> nodes;
+                std::vector<int> tree;      // row v holds the predecessor edges of the tree of v, n x n
+                std::vector<W> dist;        // row v holds the distances from v, n x n while constructing
+                std::vector<int> edges;
         };
 
 
+    namespace detail { 
+
+        // parity of the number of edges of a list which belong to a set
+        template<class Set>
+            inline int odd_intersection( const int *b, const int *e, const Set& S ) 
+            { 
+                int odd = 0;
+                for( ; b != e; ++b ) 
+                    odd ^= S.member( *b ) ? 1 : 0;
+                return odd;
+            }
+
+    } // namespace detail end
+
+    /*! Horton's superset as a sorted array of candidates. The edge lists of 
+     *  the candidates are materialized when the scan first reaches them, in a 
+     *  contiguous pool in scan order. Since every scan starts at the shortest 
+     *  candidate not yet removed, later scans stream over this pool. The edge 
+     *  lists of removed candidates are dropped from the pool once they occupy 
+     *  more than half of it.
+     */
     template<class W>
     class HortonSuperset
     {
         public:
             HortonSuperset( const graph& G_,
                     const edge_array<W>& len_, 
-                    const mcb::edge_num& enumb_ )
-                : super( leda::compare )
+                    const mcb::edge_num& enumb_, 
+                    int threads_ = 1 )
+                : hs( G_, len_, enumb_, threads_ ), first(0), dead(0), 
+                mark( G_.number_of_edges(), 0 ), stamp(0)
             { 
-                HortonSupersetBuilder<W> hs( G_, len_, enumb_ );
                 hs.construct( super );
+                offset.push_back( 0 );
             }
 
             W get_shortest_odd_cycle( const d_int_set& S, d_int_set& C, bool eraseFound = true ) { 
-                leda::seq_item s = super.min_item();
-                bool f = false;
-                W ret = W();
-                while ( s != nil ) {
-                    if ( ( (super[s]).intersect( S ) ).size() % 2 == 1 ) { // is odd
-                        C = super[s];
-                        ret = super.key( s ).first();
+                // skip erased prefix
+                while( first < super.size() && super[first].e < 0 ) 
+                    ++first;
+
+                if ( 2 * dead > pool.size() ) 
+                    compact();
+
+                for( size_t s = first; s < super.size(); ++s ) { 
+                    if ( super[s].e < 0 ) 
+                        continue;
+
+                    materialize( s );
+                    const int *b = &pool[0] + offset[s], *e = &pool[0] + offset[s+1];
+                    if ( detail::odd_intersection( b, e, S ) ) { 
+                        C.clear();
+                        for( ; b != e; ++b ) 
+                            C.insert( *b );
+                        W ret = super[s].len;
                         if ( eraseFound ) 
-                            super.del_item( s );
-                        f = true; // found
-                        break;
+                            erase( s );
+                        return ret;
                     }
-                    s = super.succ( s );
                 }
-                if ( f == false )
-                    leda::error_handler(999,"MIN_CYCLE_BASIS (HYBRID): superset contains no MCB :(");
-                return ret;
+
+                leda::error_handler(999,"MIN_CYCLE_BASIS (HYBRID): superset contains no MCB :(");
+                return W();
             }   
 
         private:
             HortonSuperset( const HortonSuperset& );
             HortonSuperset& operator=( const HortonSuperset& );
 
-            sortseq< three_tuple<W,int,int>, d_int_set > super;
+            // append the edge lists of all candidates up to s to the pool
+            void materialize( size_t s ) { 
+                while( offset.size() <= s + 1 ) { 
+                    const std::vector<int>& cyc = hs.cycle( super[ offset.size() - 1 ] );
+                    pool.insert( pool.end(), cyc.begin(), cyc.end() );
+                    offset.push_back( pool.size() );
+                }
+            }
+
+            // Remove candidate s and all its copies from other roots. The cycle 
+            // is orthogonal to all later support vectors. Copies have the same 
+            // length and size, thus they are adjacent to s.
+            void erase( size_t s ) { 
+                ++stamp;
+                for( size_t i = offset[s]; i < offset[s+1]; ++i ) 
+                    mark[ pool[i] ] = stamp;
+
+                size_t lo = s, hi = s + 1;
+                while( lo > first && ! ( super[lo-1] < super[s] ) ) 
+                    --lo;
+                while( hi < super.size() && ! ( super[s] < super[hi] ) ) 
+                    ++hi;
+
+                for( size_t k = lo; k < hi; ++k ) { 
+                    if ( k == s || super[k].e < 0 || mark[ super[k].e ] != stamp ) 
+                        continue;
+                    materialize( k );
+                    size_t i = offset[k];
+                    while( i < offset[k+1] && mark[ pool[i] ] == stamp ) 
+                        ++i;
+                    if ( i == offset[k+1] ) { 
+                        super[k].e = -1;
+                        dead += offset[k+1] - offset[k];
+                    }
+                }
+                super[s].e = -1;
+                dead += offset[s+1] - offset[s];
+            }
+
+            // Move the edge lists of the remaining scanned candidates to the 
+            // front of the pool, leaving empty lists for the removed ones. The 
+            // candidates before first are never accessed again and first is 
+            // always scanned, since only scanned candidates are removed.
+            void compact() { 
+                size_t scanned = offset.size() - 1;
+                size_t p = 0;
+                for( size_t k = first; k < scanned; ++k ) { 
+                    size_t b = offset[k], e = offset[k+1];
+                    offset[k] = p;
+                    if ( super[k].e >= 0 ) 
+                        for( size_t i = b; i < e; ++i ) 
+                            pool[p++] = pool[i];
+                }
+                offset[scanned] = p;
+
+                pool.resize( p );
+                if ( pool.capacity() > 2 * p ) 
+                    std::vector<int>( pool ).swap( pool );
+                dead = 0;
+            }
+
+            HortonSupersetBuilder<W> hs;
+            std::vector< detail::horton_candidate<W> > super;
+            size_t first;
+            size_t dead;                    // entries of the pool of removed candidates
+            std::vector<size_t> offset;     // edge lists of the scanned candidates
+            std::vector<int> pool;
+            std::vector<int> mark;
+            int stamp;
     };
 
 } // namespace mcb end
@@ -273,5 +586,3 @@ namespace mcb
 #endif  // SUPERSET_H
 
 /* ex: set ts=4 sw=4 sts=4 et: */
-
-
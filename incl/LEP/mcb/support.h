@@ -0,0 +1,67 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+
+/*! \file support.h
+ *  \brief Representation of the support vectors of the exact algorithms.
+ */
+
+#ifndef SUPPORT_H
+#define SUPPORT_H
+
+namespace mcb 
+{ 
+
+    /*! \brief Representation of the support vectors.
+     *
+     *  The Support Vector Approach maintains a set of support vectors, which at the end
+     *  of the algorithm are returned as the proof. This enumeration selects how these 
+     *  vectors are represented during the execution of the algorithm.
+     */
+    enum support_type { 
+        /*! Use the same container as the one used for the cycles. */
+        SPARSE_SUPPORT = 0,
+        /*! Use a dense matrix, see mcb::detail::bitmatgf2 for the undirected 
+         *  algorithms and mcb::detail::matfp for the directed ones. 
+         *  Requires \f$N^2/8\f$ bytes in the undirected case and \f$8 N^2\f$ bytes 
+         *  in the directed case, where \f$N\f$ is the dimension of the cycle space, 
+         *  but the support vectors are updated without any allocation using word 
+         *  parallel operations. Usually much faster on graphs with a large number of edges.
+         */
+        DENSE_SUPPORT = 1
+    };
+
+} // end of namespace mcb
+
+#endif // SUPPORT_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -0,0 +1,139 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+/*! \file threads.h
+ *  \brief Helpers for the parallel parts of the package.
+ *
+ *  The package can use multiple threads when compiled with OpenMP support, 
+ *  see the configure option --enable-openmp. Without OpenMP everything runs 
+ *  on a single thread and the thread counts given to the algorithms are ignored.
+ *
+ *  Note that parallel code never allocates memory using LEDA's memory manager,
+ *  unless LEDA has been built with multithreading support (LEDA_MULTI_THREAD).
+ */
+
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <LEP/mcb/config.h>
+#include <vector>
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mcb
+{
+
+namespace detail
+{
+
+    /*! Compute the number of threads to use.
+     *  \param requested The number of threads requested by the user. Zero or
+     *                   negative means all available processors.
+     *  \return The number of threads, always 1 without OpenMP support.
+     */
+    inline int num_threads( int requested ) 
+    { 
+#ifdef _OPENMP
+        if ( requested <= 0 ) 
+            return omp_get_num_procs();
+        return requested;
+#else
+        (void) requested;
+        return 1;
+#endif
+    }
+
+    /*! The number of the calling thread inside a parallel region, 0 otherwise. */
+    inline int thread_num() 
+    { 
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    /*! Output buffers of a parallel loop over items. Each thread appends the 
+     *  output of an item to its own buffer, between begin() and end() of the 
+     *  item. The buffers are merged in the order of the items, thus the result 
+     *  does not depend on the number of threads or the scheduling.
+     */
+    template<class T>
+    class ordered_buffers
+    {
+        public:
+            ordered_buffers( int threads, int items ) 
+                : buf( threads ), owner( items, 0 ), first( items, 0 ), last( items, 0 ) 
+            {}
+
+            /*! Start the output of an item, returns the buffer of the calling thread. */
+            std::vector<T>& begin( int item ) { 
+                int t = thread_num();
+                owner[ item ] = t;
+                first[ item ] = last[ item ] = buf[ t ].size();
+                return buf[ t ];
+            }
+
+            /*! Finish the output of an item. */
+            void end( int item ) { 
+                last[ item ] = buf[ owner[ item ] ].size();
+            }
+
+            /*! Append all output to a vector in item order and release the buffers. */
+            void merge( std::vector<T>& out ) { 
+                size_t total = out.size();
+                for( size_t t = 0; t < buf.size(); ++t ) 
+                    total += buf[ t ].size();
+                out.reserve( total );
+                for( size_t i = 0; i < owner.size(); ++i ) 
+                    out.insert( out.end(), buf[ owner[i] ].begin() + first[i], 
+                            buf[ owner[i] ].begin() + last[i] );
+                for( size_t t = 0; t < buf.size(); ++t ) 
+                    std::vector<T>().swap( buf[ t ] );
+            }
+
+        private:
+            std::vector< std::vector<T> > buf;
+            std::vector<int> owner;
+            std::vector<size_t> first, last;
+    };
+
+} // namespace detail end
+
+} // namespace mcb end
+
+#endif  // THREADS_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
@@ -6,12 +6,12 @@
 
 #ifdef LEDA_GE_V5
 #include <LEDA/graph/graph.h>
-#include <LEDA/graph/node_pq22.h>
 #else
 #include <LEDA/graph.h>
-#include <LEDA/node_pq22.h>
 #endif
 #include <limits>
+#include <LEP/mcb/heap.h>
+#include <LEP/mcb/workspace.h>
 
 namespace mcb 
 {
@@ -30,10 +30,10 @@ namespace mcb
 				node_array<W>& dist,
 				node_array<leda::edge>& pred)
 		{
-			int n = G.number_of_nodes();
-			int m = G.number_of_edges();
-
-			leda::node_pq22<W,graph> PQ(n+m); 
+			// the heap items are node indices
+			detail::pooled_workspace< detail::graph_search_workspace<W,node,edge> > ws( G.max_node_index() + 1 );
+			detail::binary_heap<W>& PQ = ws->heap;
+			ws->start();
 
 #if defined(LEDA_STD_HEADERS) || defined(__mipspro__) || defined(_MSC_VER) || defined(__DMC__)
 			W max_dist = std::numeric_limits<W>::max();
@@ -45,23 +45,26 @@ namespace mcb
 			forall_nodes(v,G) 
 			{ dist[v] = max_dist;
 				pred[v] = 0;
+				ws->nodes[ G.index(v) ] = v;
 			}
 
 			dist[s] = 0;
-			PQ.insert(s,0);
+			PQ.insert(G.index(s),0);
 
 			while (!PQ.empty())
-			{ W du;
-				node u = PQ.del_min(du,dist);  
-
-				if (du != dist[u]) continue;
+			{ node u = ws->nodes[ PQ.del_min() ];
+				W du = dist[u];
 
 				edge e;
 				forall_adj_edges(e,u)
 				{ node v = G.opposite(e,u);
 					W c = du + len[e]; 
 					if (c < dist[v]) 
-					{ PQ.insert(v,c); 
+					{ int i = G.index(v);
+						if ( PQ.member(i) ) 
+							PQ.decrease_p(i,c);
+						else
+							PQ.insert(i,c); 
 						dist[v] = c; 
 						pred[v] = e;                           
 					}
@@ -61,6 +61,8 @@
 #ifndef UMCB_H
 #define UMCB_H
 
+#include <vector>
+
 #include <LEP/mcb/config.h>
 
 #ifdef LEDA_GE_V5
@@ -80,6 +82,11 @@
 #endif
 
 #include <LEP/mcb/spvecgf2.h>
+#include <LEP/mcb/support.h>
+#include <LEP/mcb/bitmatgf2.h>
+#include <LEP/mcb/threads.h>
+#include <LEP/mcb/heap.h>
+#include <LEP/mcb/workspace.h>
 #include <LEP/mcb/signed.h>
 #include <LEP/mcb/superset.h>
 #include <LEP/mcb/sptrees.h>
@@ -99,6 +106,41 @@ namespace mcb
     using leda::list;
 #endif
 
+    /*! \brief Shortest path computations in the signed graph.
+     *
+     *  Each shortest odd cycle is found by shortest path computations in the 
+     *  signed graph. This enumeration selects how these are performed for 
+     *  weighted graphs.
+     */
+    enum search_type { 
+        /*! Run dijkstra from the source until the target is settled. */
+        UNIDIRECTIONAL_SEARCH = 0,
+        /*! Run dijkstra simultaneously from the source and the target until 
+         *  the two searches meet. Usually settles far fewer nodes on large 
+         *  sparse graphs with short cycles, such as road networks.
+         */
+        BIDIRECTIONAL_SEARCH = 1
+    };
+
+    /*! \brief Priority queue of the shortest path computations in the signed graph.
+     *
+     *  The bucket based queues require non-negative lengths of a built-in integer 
+     *  type, like int or long. For any other length type the binary heap is used. 
+     *  The computed cycles do not depend on the queue.
+     */
+    enum queue_type { 
+        /*! A binary heap, for any length type. */
+        BINARY_HEAP_QUEUE = 0,
+        /*! A monotone radix heap, \f$O(\log C)\f$ amortized time per operation 
+         *  where \f$C\f$ is the largest distance. 
+         */
+        RADIX_HEAP_QUEUE = 1,
+        /*! A bucket queue (Dial's implementation), best suited for small integer 
+         *  lengths. 
+         */
+        BUCKET_QUEUE = 2
+    };
+
     template<typename W, class Container>
     class SupportMCB
     {
@@ -108,9 +150,12 @@ namespace mcb
             SupportMCB( const graph& g_, 
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ 
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1
                         ) 
-                : g(g_), C(mcb_), S(proof_), enumb(enumb_), N(enumb_.dim_cycle_space())
+                : g(g_), C(mcb_), S(proof_), enumb(enumb_), N(enumb_.dim_cycle_space()), 
+                threads( detail::num_threads( threads_ ) ), dense( support_ == DENSE_SUPPORT )
             {
 #if ! defined(LEDA_CHECKING_OFF)
                 if ( Is_Undirected_Simple( g ) == false )
@@ -120,7 +165,11 @@ namespace mcb
                 S.resize(N);
             }
 
-            virtual ~SupportMCB() {}
+            // the members of the derived classes are already destroyed, thus
+            // all the workspaces of the computation are back in the pools
+            virtual ~SupportMCB() { 
+                mcb::release_workspaces();
+            }
 
             W run() { 
                 checkPreconditions();
@@ -138,6 +187,10 @@ namespace mcb
 #endif
                     chooseSparsestSupportHeuristic( k );
 
+                    // S[k] does not change after this point
+                    if ( dense )
+                        D.get_row( k, S[k] );
+
 #ifdef LEP_STATS
                     Torthog += leda::used_time( Ttemp );
 #endif
@@ -158,6 +211,9 @@ namespace mcb
 #ifdef LEP_STATS
                 std::cout << "LEP_STATS: cycle computation time: " << Tcycle << std::endl;
                 std::cout << "LEP_STATS: orthogonal base maintain time: " << Torthog << std::endl;
+                if ( dense )
+                    std::cout << "LEP_STATS: dense support vectors kernel: " << detail::gf2_kernel_name() << std::endl;
+                printStatistics();
 #endif
 
                 return min;
@@ -165,24 +221,48 @@ namespace mcb
 
         private:
 
+#ifdef LEP_STATS
+            virtual void printStatistics() {}
+#endif
+
             virtual void checkPreconditions() = 0;
 
             void initializeSupportVectors() {
+                if ( dense ) { 
+                    D.init( N, N );
+                    Dsize.assign( N, 1 );
+                    Ck.resize( D.words() );
+                    for( int i = 0; i < N; ++i ) { 
+                        S[i].clear(); 
+                        D.set( i, i );
+                    }
+                    return;
+                }
+
                 for( int i = 0; i < N; ++i ) { 
                     S[i].clear(); 
                     S[i].insert(i); 
                 } 
             }
 
+            int supportSize( int r ) const { 
+                return dense ? Dsize[r] : S[r].size();
+            }
+
             void chooseSparsestSupportHeuristic( int k ) { 
 #ifndef MCB_LEP_UNDIR_NO_EXCHANGE_HEURISTIC
                 int minS = k;
                 for( int r = k+1; r < N; ++r ) {
-                    if ( S[r].size() < S[minS].size() )
+                    if ( supportSize( r ) < supportSize( minS ) )
                         minS = r;
                 }
                 if ( minS != k ) {  // swap
-                    std::swap( S[k], S[minS] );
+                    if ( dense ) { 
+                        D.swap_rows( k, minS );
+                        std::swap( Dsize[k], Dsize[minS] );
+                    }
+                    else
+                        std::swap( S[k], S[minS] );
                 }
 #endif
             }
@@ -190,6 +270,32 @@ namespace mcb
             virtual W computeShortestOddCycle( int k ) = 0;
 
             void updateSupportVectors( int k ) { 
+                if ( dense ) { 
+                    D.pack( C[k], &Ck[0] );
+#ifdef _OPENMP
+                    // each thread updates a contiguous block of rows, 
+                    // rows are independent so the result equals the serial one
+                    // not worth it for less than 16K words
+                    int rows = N - k - 1;
+                    int T = ( (double) rows * D.words() < 16384.0 ) ? 1 : threads;
+                    if ( T > 1 ) { 
+#pragma omp parallel num_threads(T)
+                        { 
+                            int t = omp_get_thread_num(), nt = omp_get_num_threads();
+                            int first = k + 1 + (int) ( (double) rows * t / nt );
+                            int last = k + 1 + (int) ( (double) rows * ( t + 1 ) / nt );
+                            D.update_rows( first, last, &Ck[0], k, &Dsize[0] );
+                        }
+                        return;
+                    }
+#endif
+                    D.update_rows( k+1, N, &Ck[0], k, &Dsize[0] );
+                    return;
+                }
+
+#if defined(_OPENMP) && defined(LEDA_MULTI_THREAD)
+#pragma omp parallel for num_threads(threads) schedule(dynamic,16) if(threads > 1 && N - k > 64)
+#endif
                 for( int l = k+1; l < N; ++l )   {
                     if ( (C[k].intersect(S[l])).size() % 2 == 1 )   {
                         S[ l ] %= S[k];
@@ -203,6 +309,13 @@ namespace mcb
             array<Container>& S;
             const mcb::edge_num& enumb; 
             int N; 
+            int threads;
+
+        private:
+            bool dense;
+            detail::bitmatgf2 D;
+            std::vector<int> Dsize;
+            std::vector<detail::gf2word> Ck;
     };
 
     template<typename W, class Container>
@@ -215,8 +328,10 @@ namespace mcb
 		                const edge_array<W>& len_,
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ ) 
-                : base_type( g_, mcb_, proof_, enumb_ ), len(len_)
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1 ) 
+                : base_type( g_, mcb_, proof_, enumb_, support_, threads_ ), len(len_)
             {
             }
 
@@ -237,7 +352,9 @@ namespace mcb
             using base_type::g;
     };
 
-    template<typename W, class Container>
+    // The heap_type selects the priority queue of the signed graph searches, 
+    // detail::radix_heap or detail::dial_heap may be used for integer lengths.
+    template<typename W, class Container, class heap_type = detail::binary_heap<W> >
     class WeightedSignedSupportMCB: public WeightedSupportMCB< W, Container>
     {
         public:
@@ -247,8 +364,12 @@ namespace mcb
 		                const edge_array<W>& len_,
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ ) 
-                : base_type( g_, len_, mcb_, proof_, enumb_ ), sg(g_, len_, enumb_)
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1,
+                        search_type search_ = UNIDIRECTIONAL_SEARCH ) 
+                : base_type( g_, len_, mcb_, proof_, enumb_, support_, threads_ ), 
+                sg(g_, len_, enumb_, threads_, search_ == BIDIRECTIONAL_SEARCH )
             {
             }
 
@@ -258,8 +379,14 @@ namespace mcb
                 return sg.get_shortest_odd_cycle( S[k], C[k] );
             }
 
+#ifdef LEP_STATS
+            void printStatistics() { 
+                std::cout << "LEP_STATS: signed graph settled nodes: " << sg.settled() << std::endl;
+            }
+#endif
+
         private:
-            detail::WeightedSignedGraph<W,leda::bin_heap> sg;
+            detail::WeightedSignedGraph<W,heap_type> sg;
             using base_type::C;
             using base_type::S;
     };
@@ -273,9 +400,11 @@ namespace mcb
             UnweightedSignedSupportMCB( const graph& g_, 
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ 
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1
                         ) 
-                : base_type( g_, mcb_, proof_, enumb_ ), sg( g_, enumb_ )
+                : base_type( g_, mcb_, proof_, enumb_, support_, threads_ ), sg( g_, enumb_, threads_ )
             {
             }
 
@@ -288,6 +417,12 @@ namespace mcb
 
             void checkPreconditions() {}
 
+#ifdef LEP_STATS
+            void printStatistics() { 
+                std::cout << "LEP_STATS: signed graph settled nodes: " << sg.settled() << std::endl;
+            }
+#endif
+
         private:
             detail::UnweightedSignedGraph sg;
             using base_type::C;
@@ -304,8 +439,10 @@ namespace mcb
 		                const edge_array<W>& len_,
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ ) 
-                : base_type( g_, len_, mcb_, proof_, enumb_ ), HS( g_, len_, enumb_ )
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1 ) 
+                : base_type( g_, len_, mcb_, proof_, enumb_, support_, threads_ ), HS( g_, len_, enumb_, threads_ )
             {
             }
 
@@ -330,8 +467,11 @@ namespace mcb
 		                const edge_array<W>& len_,
                         array< Container >& mcb_, 
                         array< Container >& proof_,
-                        const mcb::edge_num& enumb_ ) 
-                : base_type( g_, len_, mcb_, proof_, enumb_ ), uhst( g_, len_, enumb_ )
+                        const mcb::edge_num& enumb_,
+                        support_type support_ = SPARSE_SUPPORT,
+                        int threads_ = 1, 
+                        size_t memory_ = 0 ) 
+                : base_type( g_, len_, mcb_, proof_, enumb_, support_, threads_ ), uhst( g_, len_, enumb_, threads_, memory_ )
             {
             }
 
@@ -349,6 +489,53 @@ namespace mcb
 
 
 
+    namespace detail { 
+
+        // Run the signed graph algorithm with the priority queue selected by 
+        // queue, the bucket based queues are instantiated only for built-in 
+        // integer lengths.
+        template<typename W, class Container, bool integer>
+        struct signed_sva 
+        { 
+            static W run( const graph& g, const edge_array<W>& len, 
+                    array< Container >& mcb, array< Container >& proof, 
+                    const mcb::edge_num& enumb, support_type support, int threads, 
+                    search_type search, queue_type ) 
+            { 
+                WeightedSignedSupportMCB<W,Container> tmp( g, len, mcb, proof, enumb, support, threads, search );
+                return tmp.run();
+            }
+        };
+
+        template<typename W, class Container>
+        struct signed_sva<W,Container,true> 
+        { 
+            static W run( const graph& g, const edge_array<W>& len, 
+                    array< Container >& mcb, array< Container >& proof, 
+                    const mcb::edge_num& enumb, support_type support, int threads, 
+                    search_type search, queue_type queue ) 
+            { 
+                switch( queue ) { 
+                    case RADIX_HEAP_QUEUE: { 
+                        WeightedSignedSupportMCB< W, Container, radix_heap<W> > tmp( 
+                                g, len, mcb, proof, enumb, support, threads, search );
+                        return tmp.run();
+                    }
+                    case BUCKET_QUEUE: { 
+                        WeightedSignedSupportMCB< W, Container, dial_heap<W> > tmp( 
+                                g, len, mcb, proof, enumb, support, threads, search );
+                        return tmp.run();
+                    }
+                    default: { 
+                        WeightedSignedSupportMCB<W,Container> tmp( g, len, mcb, proof, enumb, support, threads, search );
+                        return tmp.run();
+                    }
+                }
+            }
+        };
+
+    } // namespace detail end
+
     /*! \name Undirected Minimum Cycle Basis
      *  These functions implement the three main approaches for computing a minimum cycle basis.
      *  All these approaches are based on the <b>Support Vector Approach</b>. Their differences are
@@ -390,6 +577,9 @@ namespace mcb
      *  \param mcb A leda::array of Container to return the MCB.
      *  \param proof A leda::array of Container to return the proof.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \ingroup exactmcb
@@ -398,10 +588,12 @@ namespace mcb
 	int UMCB_SVA( const graph& g,
 		array< Container >& mcb,
 		array< Container >& proof,
-		const mcb::edge_num& enumb
+		const mcb::edge_num& enumb,
+		support_type support = SPARSE_SUPPORT,
+		int threads = 1
 		) 
 	{
-        UnweightedSignedSupportMCB<Container> tmp( g, mcb, proof, enumb );
+        UnweightedSignedSupportMCB<Container> tmp( g, mcb, proof, enumb, support, threads );
         return tmp.run();
 	}
 
@@ -425,6 +617,9 @@ namespace mcb
      *  \param g An undirected graph.
      *  \param mcb A leda::array of Container to return the MCB.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \ingroup exactmcb
@@ -432,11 +627,13 @@ namespace mcb
     template<class Container>
     int UMCB_SVA( const graph& g, 
         array< Container >& mcb, 
-        const mcb::edge_num& enumb
+        const mcb::edge_num& enumb,
+        support_type support = SPARSE_SUPPORT,
+        int threads = 1
         )
     {
         array< Container > proof;
-        return UMCB_SVA( g, mcb, proof, enumb );
+        return UMCB_SVA( g, mcb, proof, enumb, support, threads );
     }
 
     /*! \brief Compute a MCB of an undirected weighted graph using the Support Vector Approach
@@ -464,6 +661,11 @@ namespace mcb
      *  \param mcb A leda::array of Container to return the MCB.
      *  \param proof A leda::array of Container to return the proof.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
+     *  \param search The shortest path computations in the signed graph, see mcb::search_type.
+     *  \param queue The priority queue of the shortest path computations, see mcb::queue_type.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \pre len is non-negative
@@ -476,11 +678,15 @@ namespace mcb
 		const edge_array<W>& len,
 		array< Container >& mcb,
 		array< Container >& proof,
-		const mcb::edge_num& enumb
+		const mcb::edge_num& enumb,
+		support_type support = SPARSE_SUPPORT,
+		int threads = 1,
+		search_type search = UNIDIRECTIONAL_SEARCH,
+		queue_type queue = BINARY_HEAP_QUEUE
 		) 
 	{ 
-        WeightedSignedSupportMCB<W,Container> tmp( g, len, mcb, proof, enumb );
-        return tmp.run();
+        return detail::signed_sva< W, Container, detail::integer_priorities<W>::value >::run( 
+                g, len, mcb, proof, enumb, support, threads, search, queue );
     }
 
     /*! \brief Compute a MCB of an undirected weighted graph using the Support Vector Approach
@@ -504,6 +710,11 @@ namespace mcb
      *  \param len A leda::edge_array for the edge lengths.
      *  \param mcb A leda::array of Container to return the MCB.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
+     *  \param search The shortest path computations in the signed graph, see mcb::search_type.
+     *  \param queue The priority queue of the shortest path computations, see mcb::queue_type.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \pre len is non-negative
@@ -515,12 +726,15 @@ namespace mcb
 	W UMCB_SVA( const graph& g,
 		const edge_array<W>& len,
 		array< Container >& mcb,
-		const mcb::edge_num& enumb
+		const mcb::edge_num& enumb,
+		support_type support = SPARSE_SUPPORT,
+		int threads = 1,
+		search_type search = UNIDIRECTIONAL_SEARCH,
+		queue_type queue = BINARY_HEAP_QUEUE
 		) 
 	{ 
 		array< Container > proof;
-        WeightedSignedSupportMCB<W,Container> tmp( g, len, mcb, proof, enumb );
-        return tmp.run();
+        return UMCB_SVA( g, len, mcb, proof, enumb, support, threads, search, queue );
     }
 
     /*! \brief Compute a minimum cycle basis of an undirected graph using a hybrid algorithm.
@@ -541,11 +755,15 @@ namespace mcb
      *  The function returns the weight of the Minimum Cycle Basis or is undefined
      *  if there were any errors.<br> 
      *  The running time is \f$O( m^2 n^2 )\f$ where \f$m\f$ are the number of edges of \f$g\f$ 
-     *  and \f$n\f$ the number of vertices. 
+     *  and \f$n\f$ the number of vertices. The space is \f$O( n^2 )\f$ words for the shortest 
+     *  path trees, see superset.h, plus a few words for each candidate cycle. 
      *  \param g An undirected graph.
      *  \param mcb A leda::array of leda::d_int_set to return the MCB.
      *  \param proof A leda::array of leda::d_int_set to return the proof.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree 
      *  \ingroup exactmcb
@@ -553,7 +771,9 @@ namespace mcb
     extern int UMCB_HYBRID( const leda::graph& g,
             leda::array< leda::d_int_set >& mcb,
             leda::array< leda::d_int_set >& proof,
-            const mcb::edge_num& enumb
+            const mcb::edge_num& enumb,
+            support_type support = SPARSE_SUPPORT,
+            int threads = 1
             );
 
     /*! \brief Compute a minimum cycle basis of an undirected graph using a hybrid algorithm.
@@ -569,17 +789,23 @@ namespace mcb
      *  The function returns the weight of the Minimum Cycle Basis or is undefined
      *  if there were any errors.<br> 
      *  The running time is \f$O( m^2 n^2 )\f$ where \f$m\f$ are the number of edges of \f$g\f$ 
-     *  and \f$n\f$ the number of vertices. 
+     *  and \f$n\f$ the number of vertices. The space is \f$O( n^2 )\f$ words for the shortest 
+     *  path trees, see superset.h, plus a few words for each candidate cycle. 
      *  \param g An undirected graph.
      *  \param mcb A leda::array of leda::d_int_set to return the MCB.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree 
      *  \ingroup exactmcb
      */
     extern int UMCB_HYBRID( const leda::graph& g,
             leda::array< leda::d_int_set >& mcb,
-            const mcb::edge_num& enumb
+            const mcb::edge_num& enumb,
+            support_type support = SPARSE_SUPPORT,
+            int threads = 1
             );
 
 
@@ -601,12 +827,16 @@ namespace mcb
      *  The function returns the weight of the Minimum Cycle Basis or is undefined
      *  if there were any errors.<br> 
      *  The running time is \f$O( m^2 n^2 )\f$ where \f$m\f$ are the number of edges of \f$g\f$ 
-     *  and \f$n\f$ the number of vertices. 
+     *  and \f$n\f$ the number of vertices. The space is \f$O( n^2 )\f$ words for the shortest 
+     *  path trees, see superset.h, plus a few words for each candidate cycle. 
      *  \param g An undirected graph.
      *  \param len A leda::edge_array for the edge lengths.
      *  \param mcb A leda::array of leda::d_int_set to return the MCB.
      *  \param proof A leda::array of leda::d_int_set to return the proof.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree 
      *  \pre len is non-negative 
@@ -617,10 +847,12 @@ namespace mcb
                 const edge_array<W>& len,
                 array< d_int_set >& mcb,
                 array< d_int_set >& proof,
-                const mcb::edge_num& enumb
+                const mcb::edge_num& enumb,
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
                 ) 
         { 
-            WeightedHortonSupportMCB<W, d_int_set> tmp( g, len, mcb, proof, enumb );  
+            WeightedHortonSupportMCB<W, d_int_set> tmp( g, len, mcb, proof, enumb, support, threads );  
             return tmp.run();
         }
 
@@ -638,11 +870,15 @@ namespace mcb
      *  The function returns the weight of the Minimum Cycle Basis or is undefined
      *  if there were any errors.<br> 
      *  The running time is \f$O( m^2 n^2 )\f$ where \f$m\f$ are the number of edges of \f$g\f$ 
-     *  and \f$n\f$ the number of vertices. 
+     *  and \f$n\f$ the number of vertices. The space is \f$O( n^2 )\f$ words for the shortest 
+     *  path trees, see superset.h, plus a few words for each candidate cycle. 
      *  \param g An undirected graph.
      *  \param len A leda::edge_array for the edge lengths.
      *  \param mcb A leda::array of leda::d_int_set to return the MCB.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree 
      *  \pre len is non-negative 
@@ -652,11 +888,13 @@ namespace mcb
         W UMCB_HYBRID( const graph& g,
                 const edge_array<W>& len,
                 array< d_int_set >& mcb,
-                const mcb::edge_num& enumb
+                const mcb::edge_num& enumb,
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1
                 )
         {
             array< d_int_set > proof_temp;
-            return UMCB_HYBRID( g, len, mcb, proof_temp, enumb );
+            return UMCB_HYBRID( g, len, mcb, proof_temp, enumb, support, threads );
         }
 
     /*! \brief Compute a MCB of an undirected weighted graph using a Fast variant of the 
@@ -682,6 +920,15 @@ namespace mcb
      *  \param mcb A leda::array of mcb::spvecgf2 to return the MCB.
      *  \param proof A leda::array of mcb::spvecgf2 to return the proof.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
+     *  \param memory A bound in bytes on the memory of the shortest path trees, zero for no 
+     *                bound. With a bound the trees are built one at a time and only some are 
+     *                kept, evicted trees are recomputed when needed. The candidate cycles are 
+     *                then not filtered, since the filter needs all pairwise distances, thus 
+     *                more candidates are scanned and among cycles of equal length a different 
+     *                one may be chosen.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \pre len is non-negative
@@ -694,9 +941,12 @@ namespace mcb
                 const edge_array<W>& len,
                 array< mcb::spvecgf2 >& mcb, 
                 array< mcb::spvecgf2 >& proof, 
-                const mcb::edge_num& enumb ) 
+                const mcb::edge_num& enumb,
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1, 
+                size_t memory = 0 ) 
     { 
-        WeightedSPTreesSupportMCB<W,mcb::spvecgf2> tmp( g, len, mcb, proof, enumb );
+        WeightedSPTreesSupportMCB<W,mcb::spvecgf2> tmp( g, len, mcb, proof, enumb, support, threads, memory );
         return tmp.run();
     }
 
@@ -719,6 +969,15 @@ namespace mcb
      *  \param len A leda::edge_array for the edge lengths.
      *  \param mcb A leda::array of mcb::spvecgf2 to return the MCB.
      *  \param enumb An edge numbering.
+     *  \param support The representation of the support vectors, see mcb::support_type.
+     *  \param threads The number of threads to use, zero or negative for all available
+     *                 processors. Ignored without OpenMP support.
+     *  \param memory A bound in bytes on the memory of the shortest path trees, zero for no 
+     *                bound. With a bound the trees are built one at a time and only some are 
+     *                kept, evicted trees are recomputed when needed. The candidate cycles are 
+     *                then not filtered, since the filter needs all pairwise distances, thus 
+     *                more candidates are scanned and among cycles of equal length a different 
+     *                one may be chosen.
      *  \return The length of the MCB or undefined if some error occured.
      *  \pre g is undirected, simple and loopfree.
      *  \pre len is non-negative
@@ -730,10 +989,13 @@ namespace mcb
     W UMCB_FH( const graph& g, 
                 const edge_array<W>& len,
                 array< mcb::spvecgf2 >& mcb, 
-                const mcb::edge_num& enumb ) 
+                const mcb::edge_num& enumb,
+                support_type support = SPARSE_SUPPORT,
+                int threads = 1, 
+                size_t memory = 0 ) 
     { 
         array< mcb::spvecgf2 > proof;
-        WeightedSPTreesSupportMCB<W,mcb::spvecgf2> tmp( g, len, mcb, proof, enumb );
+        WeightedSPTreesSupportMCB<W,mcb::spvecgf2> tmp( g, len, mcb, proof, enumb, support, threads, memory );
         return tmp.run();
     }
 
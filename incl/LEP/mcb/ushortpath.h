@@ -36,6 +36,7 @@
 #ifndef USHORTPATH_H
 #define USHORTPATH_H
 
+#include <vector>
 #include <LEP/mcb/config.h>
 
 #ifdef LEDA_GE_V5
@@ -44,19 +45,17 @@
 #include <LEDA/graph/node_array.h>
 #include <LEDA/core/array.h>
 #include <LEDA/core/list.h>
-#include <LEDA/core/impl/f_heap.h>
 #include <LEDA/core/impl/bin_heap.h>
-#include <LEDA/graph/node_pq.h>
 #else
 #include <LEDA/graph.h>
 #include <LEDA/edge_array.h>
 #include <LEDA/node_array.h>
 #include <LEDA/array.h>
 #include <LEDA/list.h>
-#include <LEDA/impl/f_heap.h>
 #include <LEDA/impl/bin_heap.h>
-#include <LEDA/node_pq.h>
 #endif
+#include <LEP/mcb/heap.h>
+#include <LEP/mcb/workspace.h>
 
 // start our namespace
 namespace mcb 
@@ -70,17 +69,52 @@ namespace mcb
     using leda::edge;
     using leda::edge_array;
     using leda::list;
-    using leda::node_pq;
     using leda::error_handler;
 #endif
 
     namespace detail 
     {
 
+	/*! The adjacency of a graph in compressed sparse row format. Every edge
+	 *  appears in the adjacency of both its endpoints, whether the graph is 
+	 *  directed or not. Nodes are numbered in the order of the node list.
+	 *
+	 *  \author Dimitrios Michail
+	 *  \date 2006
+	 */
+	class uadjacency
+	{
+	    public:
+		/*! Constructor
+		 *  \param G The graph
+		 */
+		uadjacency( const graph& G );
+
+		/*! The number of a node. */
+		int index( const node& v ) const { return id[v]; }
+
+		node_array<int> id;		// number of each node
+		std::vector<int> first;		// first arc of each node, size n+1
+		std::vector<int> adj_node;	// opposite node of each arc
+		std::vector<edge> adj_edge;	// edge of each arc
+	};
+
 	/*! A class to provide undirected weighted single source single target 
 	 *  shortest path queries. This is especially useful if shortest 
 	 *  paths between several pair of nodes are requested.
 	 *
+	 *  The search arrays are taken from the workspace pool and are 
+	 *  invalidated by generation stamps, thus a query performs no 
+	 *  memory allocation and its cost does not depend on the previous one.
+	 *  The arrays stay in the pool after the object is destroyed, until 
+	 *  mcb::release_workspaces() is called. The adjacency is copied at 
+	 *  construction, the graph must not change afterwards.
+	 *
+	 *  The priority queue implementation prio_impl may be one of the heaps 
+	 *  of the library, like detail::radix_heap for integer lengths. The LEDA 
+	 *  implementations, like the default leda::bin_heap, are still accepted 
+	 *  for compatibility and are replaced by detail::binary_heap.
+	 *
 	 *  \author Dimitrios Michail
 	 *  \date 2006
 	 */
@@ -88,15 +122,18 @@ namespace mcb
 	    class ushortestpaths
 	    {
 		public:
+		    typedef typename heap_selector<W,prio_impl>::type heap_type;
+		    typedef search_workspace<W,heap_type> workspace_type;
+
 		    ushortestpaths( const graph& G, const edge_array<W>& l ) 
-			: g(G), 
-			len(l), 
-			_pred(G, nil), 
-			_dist( G, W() ), 
-			// bin heap fails if called with empty graph
-			pq( G, G.number_of_nodes() > 0 ? G.number_of_nodes() : 1 ),
-			last_s( nil )
-			{}
+			: adj( G ), 
+			ws( G.number_of_nodes() )
+			{
+			    adj_len.resize( adj.adj_edge.size() );
+			    for( size_t a = 0; a < adj_len.size(); ++a ) 
+				adj_len[a] = l[ adj.adj_edge[a] ];
+			    ws->start();
+			}
 
 		    ~ushortestpaths() {}
 
@@ -106,79 +143,43 @@ namespace mcb
 		     */
 		    void compute_shortest_path( const node& s, const node& t ) 
 		    {
-			// init pred array from previous runs
-			while( touched.empty() == false ) {
-			    _pred[ touched.pop() ] = nil;
-			}
-			pq.clear();
-
-			node u,w;
-			edge e;
+			workspace_type& f = *ws;
+			int si = adj.index( s );
+			int ti = adj.index( t );
 
 			// set initial values
-			_pred[s] = nil;
-			_dist[s] = 0;
-			last_s = s;
-			touched.push(s);
-			pq.insert( s, 0 );
+			f.start();
+			f.reach( si, 0, -1, -1 );
+			f.heap.insert( si, 0 );
 
 			// main loop
-			while( ! pq.empty() ) 
+			while( ! f.heap.empty() ) 
 			{ 
-			    u = pq.del_min(); // del min
+			    int u = f.heap.del_min(); // del min
 
-			    if ( u == t )   // found target
+			    if ( u == ti )   // found target
 				return;
 
 			    // update or add
-			    if ( g.is_undirected() )
-				// code duplication due to LEDA-6.0 change in macro
-				// forall_inout_edges
-				// Prior to 6.0 only one loop with forall_inout_edges worked
-				// for both undirected and directed graphs
-				forall_adj_edges( e, u ) 
-				{
-				    w = g.opposite( u, e );
-				    W c = _dist[u] + len[ e ];
+			    for( int a = adj.first[u]; a < adj.first[u+1]; ++a ) 
+			    {
+				int w = adj.adj_node[a];
+				W c = f.dist[u] + adj_len[a];
 
 #if !defined(LEDA_CHECKING_OFF)
-				    if ( c < 0 )
-					error_handler(999,"USHORTPATH: negative distance (overflow?)");
+				if ( c < 0 )
+				    error_handler(999,"USHORTPATH: negative distance (overflow?)");
 #endif
-				    if ( _pred[w] == nil && w != s ) { // add
-					pq.insert( w, c );
-					touched.push( w );
-				    }
-				    else if ( c < _dist[w] ) { // decrease key
-					pq.decrease_p( w, c );
-				    }
-				    else continue;
-
-				    _dist[w] = c;
-				    _pred[w] = e;
+				if ( ! f.reached( w ) ) { // add
+				    f.heap.insert( w, c );
 				}
-			    else
-				forall_inout_edges( e, u ) 
-				{
-				    w = g.opposite( u, e );
-				    W c = _dist[u] + len[ e ];
-
-#if !defined(LEDA_CHECKING_OFF)
-				    if ( c < 0 )
-					error_handler(999,"USHORTPATH: negative distance (overflow?)");
-#endif
-				    if ( _pred[w] == nil && w != s ) { // add
-					pq.insert( w, c );
-					touched.push( w );
-				    }
-				    else if ( c < _dist[w] ) { // decrease key
-					pq.decrease_p( w, c );
-				    }
-				    else continue;
-
-				    _dist[w] = c;
-				    _pred[w] = e;
+				else if ( c < f.dist[w] ) { // decrease key
+				    f.heap.decrease_p( w, c );
 				}
+				else continue;
+
+				f.reach( w, c, u, a );
+			    }
 			}
 		    }
 
@@ -186,7 +187,12 @@ namespace mcb
 		     *  \param v A node
 		     *  \return The predecessor edge of a node
 		     */
-		    edge pred( const node& v ) { return _pred[v]; }
+		    edge pred( const node& v ) { 
+			int i = adj.index( v );
+			if ( ! ws->reached( i ) || ws->pred_edge[i] < 0 ) 
+			    return nil;
+			return adj.adj_edge[ ws->pred_edge[i] ]; 
+		    }
 
 		    /*! Get the distance of a node from the source node in the last 
 		     *  shortest path computation.
@@ -196,10 +202,10 @@ namespace mcb
 		     */
 		    W dist( const node& v ) { 
 #if ! defined(LEDA_CHECKING_OFF)
-			if ( _pred[v] == nil ) 
+			if ( ! is_reachable( v ) ) 
 			    std::cerr << "ushortestpaths: returning distance of unreachable vertex!" << std::endl;
 #endif
-			return _dist[v]; 
+			return ws->dist[ adj.index( v ) ]; 
 		    }
 
 		    /*! Check if a node v is reachable from the source node of the last shortest path
@@ -209,20 +215,13 @@ namespace mcb
 		     *	    computation
 		     */
 		    bool is_reachable( const node& v ) { 
-			if ( v == last_s )
-			    return true;
-			return _pred[v] != nil; 
+			return ws->reached( adj.index( v ) ); 
 		    }
 
 		private:
-		    const graph& g;
-		    const edge_array<W>& len;
-
-		    list<node> touched;
-		    node_array<edge> _pred;
-		    node_array<W> _dist;
-		    node_pq<W,graph,prio_impl> pq;
-		    node last_s;
+		    uadjacency adj;
+		    std::vector<W> adj_len;
+		    pooled_workspace<workspace_type> ws;
 	    };
 
 
@@ -230,12 +229,19 @@ namespace mcb
 	 *  shortest path queries. This is especially useful if shortest 
 	 *  paths between several pair of nodes are requested.
 	 *
+	 *  As in ushortestpaths the search arrays are taken from the workspace pool.
+	 *  The search follows the adjacency lists of the graph and nodes are 
+	 *  identified by their index, thus edges may be added to the graph between
+	 *  two queries.
+	 *
 	 *  \author Dimitrios Michail
 	 *  \date 2006
 	 */
 	class ubfs
 	{
 	    public:
+		typedef graph_search_workspace<int,node,edge> workspace_type;
+
 		/*! Constructor
 		 *  \param G The graph to do BFS in
 		 */
@@ -256,7 +262,10 @@ namespace mcb
 		 *  \param v A node
 		 *  \return The predecessor edge of a node
 		 */
-		edge pred( const node& v ) { return pred_[v]; }
+		edge pred( const node& v ) { 
+		    int i = g.index( v );
+		    return ws->reached( i ) ? ws->pred_link[i] : nil; 
+		}
 
 		/*! Get the distance of a node from the source node in the last 
 		 *  shortest path computation.
@@ -266,10 +275,10 @@ namespace mcb
 		 */
 		int dist( const node& v ) { 
 #if ! defined(LEDA_CHECKING_OFF)
-		    if ( pred_[v] == nil ) 
+		    if ( ! is_reachable( v ) ) 
 			std::cerr << "ushortestpaths: returning distance of unreachable vertex!" << std::endl;
 #endif
-		    return dist_[v]; 
+		    return ws->dist[ g.index( v ) ]; 
 		}
 
 		/*! Check if a node v is reachable from the source node of the last shortest path
@@ -279,18 +288,14 @@ namespace mcb
 		 *	    computation
 		 */
 		bool is_reachable( const node& v ) { 
-		    if ( v == last_s )
-			return true;
-		    return pred_[v] != nil; 
+		    return ws->reached( g.index( v ) ); 
 		}
 
 	    private:
-		const graph& g;
+		bool visit( workspace_type& f, int i, const node& w, const edge& e );
 
-		list<node> Q;
-		node_array<edge> pred_;
-		node_array<int> dist_;
-		node last_s;
+		const graph& g;
+		pooled_workspace<workspace_type> ws;
 	};
 
     }
@@ -0,0 +1,272 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+/*! \file workspace.h
+ *  \brief Reusable scratch space of the single source shortest path computations.
+ */
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <vector>
+#include <algorithm>
+#include <LEP/mcb/config.h>
+#include <LEP/mcb/heap.h>
+
+namespace mcb
+{
+
+namespace detail
+{
+
+    /*! \brief Scratch space of a single source search on the nodes \f$0,\dots,n-1\f$.
+     *
+     *  The distance and predecessors of a node are valid only if the node has been 
+     *  reached in the current search, that is if its stamp equals the current generation. 
+     *  Starting a new search increments the generation, thus takes constant time 
+     *  besides emptying the queues, instead of resetting the arrays. The stamps are 
+     *  cleared only when the generation counter wraps around.
+     *
+     *  The workspace never shrinks, once it has been initialized for \f$n\f$ nodes 
+     *  searches on at most \f$n\f$ nodes perform no memory allocation.
+     */
+    template<typename W, class heap_type = binary_heap<W> >
+    struct search_workspace
+    {
+        std::vector<W> dist;            // distance from the source
+        std::vector<int> pred;          // predecessor node, -1 for the source
+        std::vector<int> pred_edge;     // predecessor edge, numbered by the user
+        std::vector<unsigned> seen;     // generation of the last search which reached each node
+        unsigned gen;                   // current generation
+        std::vector<int> queue;         // bfs queue
+        heap_type heap;                 // dijkstra queue
+
+        search_workspace() : gen( 0 ) {}
+
+        /*! Make room for searches on \f$n\f$ nodes. */
+        void init( int n ) { 
+            if ( n <= capacity() ) 
+                return;
+            dist.resize( n, W() );
+            pred.resize( n, -1 );
+            pred_edge.resize( n, -1 );
+            seen.resize( n, 0 );
+            queue.reserve( n );
+            heap.init( n );
+        }
+
+        int capacity() const { return (int) seen.size(); }
+
+        /*! Start a new search, all nodes become unreached. */
+        void start() { 
+            if ( ++gen == 0 ) {  // wrap around
+                std::fill( seen.begin(), seen.end(), 0 );
+                gen = 1;
+            }
+            queue.clear();
+            heap.clear();
+        }
+
+        bool reached( int v ) const { return seen[v] == gen; }
+
+        void reach( int v, const W& d, int p, int pe ) { 
+            seen[v] = gen;
+            dist[v] = d;
+            pred[v] = p;
+            pred_edge[v] = pe;
+        }
+    };
+
+    /*! \brief Scratch space of a single source search on the nodes of a graph, which 
+     *         are identified by an index.
+     *
+     *  Besides the arrays of search_workspace it records the node of each index, 
+     *  needed to go from the items of the queues to the nodes, and the predecessor 
+     *  edge of each node as an object of type E.
+     */
+    template<typename W, typename N, typename E>
+    struct graph_search_workspace : public search_workspace<W>
+    {
+        std::vector<N> nodes;           // node of each index
+        std::vector<E> pred_link;       // predecessor edge of each node
+
+        void init( int n ) { 
+            search_workspace<W>::init( n );
+            if ( (int) nodes.size() < n ) { 
+                nodes.resize( n );
+                pred_link.resize( n );
+            }
+        }
+    };
+
+    typedef void (*pool_clear_function)();
+
+    /* The clear() functions of the pools which have been used, guarded by the 
+     * critical section of the pools. 
+     */
+    inline std::vector<pool_clear_function>& pool_registry() 
+    { 
+        static std::vector<pool_clear_function> r;
+        return r;
+    }
+
+    /*! \brief A pool of workspaces shared by all the computations of the library.
+     *
+     *  The workspaces are kept after their release, so a computation which is 
+     *  repeated many times, like a shortest path query from each vertex, reuses 
+     *  the same storage. They are freed by clear(), which the minimum cycle basis 
+     *  functions call through mcb::release_workspaces() when they finish. 
+     *  Workspaces can be acquired and released concurrently by different threads. 
+     *  The type T must provide a default constructor and a method init(n) which 
+     *  makes room for \f$n\f$ items.
+     */
+    template<class T>
+    class workspace_pool
+    {
+        public:
+            static T* acquire( int n ) { 
+                T* w = 0;
+#ifdef _OPENMP
+#pragma omp critical(mcb_workspace_pool)
+#endif
+                { 
+                    std::vector<T*>& l = free_list().l;
+                    if ( ! l.empty() ) { 
+                        w = l.back();
+                        l.pop_back();
+                    }
+                }
+                if ( w == 0 ) 
+                    w = new T();
+                w->init( n );
+                return w;
+            }
+
+            static void release( T* w ) { 
+#ifdef _OPENMP
+#pragma omp critical(mcb_workspace_pool)
+#endif
+                free_list().l.push_back( w );
+            }
+
+            /*! Free the workspaces which are not acquired. Workspaces which are 
+             *  currently in use are kept, and return to the pool on release. 
+             */
+            static void clear() { 
+                std::vector<T*> l;
+#ifdef _OPENMP
+#pragma omp critical(mcb_workspace_pool)
+#endif
+                l.swap( free_list().l );
+                for( size_t i = 0; i < l.size(); ++i ) 
+                    delete l[i];
+            }
+
+        private:
+            // called inside the critical section
+            struct holder { 
+                std::vector<T*> l;
+                holder() { 
+                    pool_registry().push_back( &workspace_pool<T>::clear );
+                }
+                ~holder() { 
+                    for( size_t i = 0; i < l.size(); ++i ) 
+                        delete l[i];
+                }
+            };
+
+            static holder& free_list() { 
+                static holder h;
+                return h;
+            }
+    };
+
+    /*! \brief A workspace acquired from the pool for the lifetime of this object. */
+    template<class T>
+    class pooled_workspace
+    {
+        public:
+            pooled_workspace() : w( 0 ) {}
+
+            explicit pooled_workspace( int n ) : w( workspace_pool<T>::acquire( n ) ) {}
+
+            ~pooled_workspace() { 
+                if ( w != 0 ) 
+                    workspace_pool<T>::release( w );
+            }
+
+            /*! Acquire a workspace for \f$n\f$ items, or enlarge the current one. */
+            void acquire( int n ) { 
+                if ( w != 0 ) 
+                    w->init( n );
+                else
+                    w = workspace_pool<T>::acquire( n );
+            }
+
+            T* get() const { return w; }
+            T& operator*() const { return *w; }
+            T* operator->() const { return w; }
+
+        private:
+            pooled_workspace( const pooled_workspace& );
+            pooled_workspace& operator=( const pooled_workspace& );
+
+            T* w;
+    };
+
+} // namespace detail end
+
+    /*! \brief Free the workspaces of the shortest path computations which are 
+     *         not in use.
+     *
+     *  The workspaces are kept between searches and grow to the largest graph 
+     *  searched. The minimum cycle basis functions call this function when they 
+     *  finish, programs which call the shortest path functions directly may 
+     *  call it to get the memory back. It is safe to call it while other threads 
+     *  compute, only idle workspaces are freed.
+     */
+    inline void release_workspaces() 
+    { 
+        std::vector<detail::pool_clear_function> r;
+#ifdef _OPENMP
+#pragma omp critical(mcb_workspace_pool)
+#endif
+        r = detail::pool_registry();
+        for( size_t i = 0; i < r.size(); ++i ) 
+            (*r[i])();
+    }
+
+} // namespace mcb end
+
+#endif  // WORKSPACE_H
+
+/* ex: set ts=4 sw=4 sts=4 et: */
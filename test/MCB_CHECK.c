@@ -0,0 +1,362 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include <LEP/mcb/mcb.h>
+#include <LEP/mcb/verify.h>
+#include <LEP/mcb/util.h>
+
+#if defined(LEDA_NAMESPACE)
+using namespace leda;
+#endif
+
+// Check that the different ways of computing an exact MCB give the same result 
+// as the sparse computation on a single thread, on random graphs. 
+//
+// Undirected graphs are checked with dense support vectors, several threads, 
+// bidirectional searches, each priority queue, the breadth first searches of 
+// unit lengths, the hybrid algorithms and bounds on the memory of the shortest 
+// path trees. Directed graphs are checked with dense support vectors, several 
+// threads, primes for which the searches use a flat array or a hash table, and 
+// concurrent trials. Every basis must be a cycle basis with the weight of the 
+// reference. Where the modes promise it, the basis itself must be the same.
+//
+// The lengths are of type long, thus the program has its own instances of the 
+// algorithms even when compiled with different options than the library, see 
+// MCB_CHECK_NOFILTER.c.
+
+// A linear congruential generator, thus the graphs do not depend on the 
+// platform.
+unsigned long state;
+
+int next_int( int bound ) 
+{ 
+    state = state * 6364136223846793005UL + 1442695040888963407UL;
+    return (int) ( ( state >> 33 ) % (unsigned long) bound );
+}
+
+// A connected random simple graph with n nodes and m edges, without 
+// anti-parallel edges when directed.
+void random_graph( graph& G, int n, int m, bool undirected ) 
+{ 
+    G.clear();
+    std::vector<node> V( n );
+    for( int i = 0; i < n; ++i ) 
+        V[i] = G.new_node();
+
+    std::vector<char> used( n * n, 0 );
+    for( int i = 1; i < n; ++i ) { 
+        int j = next_int( i );
+        used[ j * n + i ] = used[ i * n + j ] = 1;
+        G.new_edge( V[j], V[i] );
+    }
+    if ( m > n * ( n - 1 ) / 2 ) 
+        m = n * ( n - 1 ) / 2;
+    while( G.number_of_edges() < m ) { 
+        int a = next_int( n ), b = next_int( n );
+        if ( a == b || used[ a * n + b ] ) 
+            continue;
+        used[ a * n + b ] = used[ b * n + a ] = 1;
+        G.new_edge( V[a], V[b] );
+    }
+    if ( undirected ) 
+        G.make_undirected();
+}
+
+bool equal( const mcb::spvecgf2& a, const mcb::spvecgf2& b ) 
+{ 
+    mcb::spvecgf2 x = a;
+    x %= b;
+    return x.size() == 0;
+}
+
+bool equal( const leda::d_int_set& a, const leda::d_int_set& b ) 
+{ 
+    return a == b;
+}
+
+bool equal( const mcb::spvecfp& a, const mcb::spvecfp& b ) 
+{ 
+    mcb::spvecfp x = a;
+    x -= b;
+    return x.size() == 0;
+}
+
+int checks = 0;
+int failures = 0;
+
+// Compares the bases of the different modes with the basis of the reference.
+template<class Container>
+class comparison
+{
+    public:
+        comparison( const graph& G_, const edge_array<long>& len_, const mcb::edge_num& enumb_, 
+                long wref_, const array< Container >& ref_ ) 
+            : G(G_), len(len_), enumb(enumb_), wref(wref_), ref(ref_)
+        {
+            check( "reference", wref, ref );
+        }
+
+        // same: whether the basis must also be equal to the reference
+        void check( const char* mode, long w, const array< Container >& B, bool same = false ) 
+        { 
+            mcb::ComputeWeight<long,Container> weight( G, len, enumb );
+            long sum = 0;
+            for( int i = 0; i < B.size(); ++i ) 
+                sum += weight( B[i] );
+
+            bool ok = ( w == wref && sum == w && mcb::verify_cycle_basis( G, enumb, B ) );
+            for( int i = 0; ok && same && i < B.size(); ++i ) 
+                ok = equal( B[i], ref[i] );
+
+            ++checks;
+            if ( ! ok ) { 
+                ++failures;
+                std::cerr << "  " << mode << ": weight " << w << ", expected " << wref;
+                std::cerr << ( same ? ", or the basis differs" : ", or not a cycle basis" ) << std::endl;
+            }
+        }
+
+    private:
+        const graph& G;
+        const edge_array<long>& len;
+        const mcb::edge_num& enumb;
+        long wref;
+        array< Container > ref;
+};
+
+// the undirected modes
+long check_undirected( const graph& G, const edge_array<long>& len, int threads ) 
+{ 
+    mcb::edge_num enumb( G );
+
+    array< mcb::spvecgf2 > R;
+    long wref = mcb::UMCB_SVA( G, len, R, enumb );
+    comparison< mcb::spvecgf2 > C( G, len, enumb, wref, R );
+
+    {
+        array< mcb::spvecgf2 > B;
+        C.check( "dense", mcb::UMCB_SVA( G, len, B, enumb, mcb::DENSE_SUPPORT ), B, true );
+        C.check( "threads", mcb::UMCB_SVA( G, len, B, enumb, mcb::SPARSE_SUPPORT, threads ), B, true );
+        C.check( "dense, threads", mcb::UMCB_SVA( G, len, B, enumb, mcb::DENSE_SUPPORT, threads ), B, true );
+        C.check( "bidirectional", mcb::UMCB_SVA( G, len, B, enumb, mcb::SPARSE_SUPPORT, 1, 
+                    mcb::BIDIRECTIONAL_SEARCH ), B );
+        C.check( "bidirectional, dense, threads", mcb::UMCB_SVA( G, len, B, enumb, mcb::DENSE_SUPPORT, threads, 
+                    mcb::BIDIRECTIONAL_SEARCH ), B );
+        C.check( "radix heap", mcb::UMCB_SVA( G, len, B, enumb, mcb::SPARSE_SUPPORT, 1, 
+                    mcb::UNIDIRECTIONAL_SEARCH, mcb::RADIX_HEAP_QUEUE ), B, true );
+        C.check( "bucket queue, threads", mcb::UMCB_SVA( G, len, B, enumb, mcb::SPARSE_SUPPORT, threads, 
+                    mcb::UNIDIRECTIONAL_SEARCH, mcb::BUCKET_QUEUE ), B, true );
+        C.check( "bidirectional, radix heap", mcb::UMCB_SVA( G, len, B, enumb, mcb::SPARSE_SUPPORT, threads, 
+                    mcb::BIDIRECTIONAL_SEARCH, mcb::RADIX_HEAP_QUEUE ), B );
+    }
+
+    // the bases of the hybrid algorithms do not depend on the support vectors 
+    // or the threads, but may differ from the one of the signed graph
+    {
+        array< leda::d_int_set > H, B;
+        long w = mcb::UMCB_HYBRID( G, len, H, enumb );
+        comparison< leda::d_int_set > CH( G, len, enumb, wref, H );
+        CH.check( "hybrid", w, H );
+        CH.check( "hybrid, dense", mcb::UMCB_HYBRID( G, len, B, enumb, mcb::DENSE_SUPPORT ), B, true );
+        CH.check( "hybrid, dense, threads", mcb::UMCB_HYBRID( G, len, B, enumb, mcb::DENSE_SUPPORT, threads ), B, true );
+    }
+
+    {
+        array< mcb::spvecgf2 > F, B;
+        long w = mcb::UMCB_FH( G, len, F, enumb );
+        comparison< mcb::spvecgf2 > CF( G, len, enumb, wref, F );
+        CF.check( "labelled trees", w, F );
+        CF.check( "labelled trees, dense", mcb::UMCB_FH( G, len, B, enumb, mcb::DENSE_SUPPORT ), B, true );
+        CF.check( "labelled trees, threads", mcb::UMCB_FH( G, len, B, enumb, mcb::SPARSE_SUPPORT, threads ), B, true );
+
+        // without the filter of the candidates a different basis may be chosen, 
+        // keep a single tree or a few of them
+        size_t few = (size_t) G.number_of_nodes() * G.number_of_nodes() * sizeof(int) / 4;
+        CF.check( "labelled trees, memory bound", mcb::UMCB_FH( G, len, B, enumb, mcb::SPARSE_SUPPORT, 1, 1 ), B );
+        CF.check( "labelled trees, memory bound, dense, threads", mcb::UMCB_FH( G, len, B, enumb, 
+                    mcb::DENSE_SUPPORT, threads, few ), B );
+    }
+
+    // unit lengths, the unweighted searches are breadth first
+    edge_array<long> one( G, 1 );
+    array< mcb::spvecgf2 > U;
+    long wone = mcb::UMCB_SVA( G, one, U, enumb );
+    comparison< mcb::spvecgf2 > C1( G, one, enumb, wone, U );
+    {
+        array< mcb::spvecgf2 > B;
+        C1.check( "unweighted", mcb::UMCB_SVA( G, B, enumb ), B );
+        C1.check( "unweighted, dense, threads", mcb::UMCB_SVA( G, B, enumb, mcb::DENSE_SUPPORT, threads ), B );
+    }
+
+    return wref;
+}
+
+// the directed modes
+long check_directed( const graph& G, const edge_array<long>& len, int threads ) 
+{ 
+    mcb::edge_num enumb( G );
+
+    // the searches index their states by a flat array for the small prime and 
+    // by a hash table for the large one
+    mcb::ptype small = 10007;
+    mcb::ptype large = 2147483647;
+
+    array< mcb::spvecfp > R, X;
+    long wref = mcb::DMCB( G, len, R, X, enumb, large );
+    comparison< mcb::spvecfp > C( G, len, enumb, wref, R );
+
+    array< mcb::spvecfp > B;
+    C.check( "dense", mcb::DMCB( G, len, B, X, enumb, large, mcb::DENSE_SUPPORT ), B, true );
+    C.check( "threads", mcb::DMCB( G, len, B, X, enumb, large, mcb::SPARSE_SUPPORT, threads ), B, true );
+    C.check( "dense, threads", mcb::DMCB( G, len, B, X, enumb, large, mcb::DENSE_SUPPORT, threads ), B, true );
+    C.check( "small prime", mcb::DMCB( G, len, B, X, enumb, small ), B );
+    C.check( "small prime, dense, threads", mcb::DMCB( G, len, B, X, enumb, small, mcb::DENSE_SUPPORT, threads ), B );
+
+#ifdef MCB_LEP_WORD_PRIMES
+    // independent trials, the result is the first trial of minimum weight 
+    // whether the trials run concurrently or not
+    std::vector< mcb::ptype > P;
+    P.push_back( 10009 );
+    P.push_back( small );
+    P.push_back( 10037 );
+    P.push_back( large );
+    long wmin = 0;
+    array< mcb::spvecfp > M;
+    for( size_t k = 0; k < P.size(); ++k ) { 
+        long w = mcb::DMCB( G, len, B, X, enumb, P[k] );
+        if ( k == 0 || w < wmin ) { 
+            wmin = w;
+            M = B;
+        }
+    }
+    comparison< mcb::spvecfp > CT( G, len, enumb, wref, M );
+    CT.check( "trials", mcb::detail::DMCB_word_trials( G, len, B, X, enumb, P, false, 1 ), B, true );
+    CT.check( "trials, threads", mcb::detail::DMCB_word_trials( G, len, B, X, enumb, P, false, threads ), B, true );
+    CT.check( "trials, dense, threads", mcb::detail::DMCB_word_trials( G, len, B, X, enumb, P, true, threads ), B, true );
+#endif
+
+    return wref;
+}
+
+void print_usage(const char * program)
+{
+    std::cout << "Usage: "<< program <<" [-n value] [-r value] [-t value]" << std::endl;
+    std::cout << "Compute the MCB of random graphs in every mode of the exact algorithms and" << std::endl;
+    std::cout << "compare it with the MCB computed with sparse support vectors on a single thread." << std::endl;
+    std::cout << "Exits with a non-zero status if any of them differs." << std::endl;
+    std::cout << std::endl;
+    std::cout <<"-n value" << std::endl;
+    std::cout <<"          Number of random graphs. Default value is 20." << std::endl;
+    std::cout <<"-r value" << std::endl;
+    std::cout <<"          Seed of the random number generator. Default value is 1." << std::endl;
+    std::cout <<"-t value" << std::endl;
+    std::cout <<"          Number of threads of the threaded modes. Default value is 4." << std::endl;
+    std::cout <<"-h" << std::endl;
+    std::cout <<"          Display this message." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+
+    int graphs = 20;
+    int seed = 1;
+    int threads = 4;
+    int c;
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "n:r:t:h")) != -1)
+        switch (c)
+        {
+            case 'n':
+                graphs = atoi( optarg );
+                break;
+            case 'r':
+                seed = atoi( optarg );
+                break;
+            case 't':
+                threads = atoi( optarg );
+                if ( threads < 2 ) 
+                    threads = 2;
+                break;
+            case 'h':
+            default:
+                print_usage( argv[0] );
+                exit( EXIT_SUCCESS );
+        }
+
+#ifdef MCB_LEP_UNDIR_NO_ISOMETRIC_FILTER
+    std::cout << "isometric filter of Horton's superset disabled" << std::endl;
+#endif
+
+    state = seed;
+    for( int r = 0; r < graphs; ++r ) { 
+        // the last graph is large enough for the vectorized kernels and the 
+        // parallel support vector updates
+        bool last = ( r + 1 == graphs );
+        int n = last ? 200 : 5 + next_int( 30 );
+        int m = last ? 720 : n + next_int( 2 * n );
+        int maxlen = ( r % 3 == 0 ) ? 1 : 10;
+
+        graph G;
+        random_graph( G, n, m, true );
+        edge e;
+        edge_array<long> len( G );
+        forall_edges( e, G ) 
+            len[ e ] = 1 + next_int( maxlen );
+
+        int failed = failures;
+        std::cout << "graph " << r << ": n=" << n << " m=" << G.number_of_edges() << std::endl;
+        long w = check_undirected( G, len, threads );
+        std::cout << "  undirected weight " << w << std::endl;
+
+        if ( ! last ) { 
+            random_graph( G, n, m, false );
+            len.init( G );
+            forall_edges( e, G ) 
+                len[ e ] = 1 + next_int( maxlen );
+            w = check_directed( G, len, threads );
+            std::cout << "  directed weight " << w << std::endl;
+        }
+        if ( failures > failed ) 
+            std::cout << "  FAILED" << std::endl;
+    }
+
+    std::cout << checks << " comparisons, " << failures << " failures" << std::endl;
+    return ( failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ex: set ts=4 sw=4 sts=4 et: */
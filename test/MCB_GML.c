@@ -30,6 +30,7 @@
 //
 
 #include <iostream>
+#include <string>
 #include <stdio.h>
 #include <sys/resource.h>
 #include <LEP/mcb/determinant.h>
@@ -73,7 +74,8 @@ bool get_edge_weight( const gml_object* gobj, graph* G, edge e ) {
 
 void print_usage(const char * program)
 {
-    std::cout << "Usage: "<< program <<" [-w] [-s] [-c] [-f] [-p] [-q] [-d] [-k value] [-e value]" << std::endl;
+    std::cout << "Usage: "<< program <<" [-w] [-s] [-b] [-c] [-f] [-p] [-q] [-d] [-k value] [-e value]" << std::endl;
+    std::cout << "       [-D] [-t value] [-M value] [-Q value]" << std::endl;
     std::cout << "Read a GML graph from standard input and compute its MCB." << std::endl;
     std::cout << std::endl;
     std::cout << "Without any options the program selects the best algorithm." << std::endl;
@@ -85,6 +87,10 @@ void print_usage(const char * program)
     std::cout <<"          Each label entry should be either \"weight\" or \"uniquenumber (weight)\"" << std::endl;
     std::cout <<"-s" << std::endl;
     std::cout <<"          Use the support vector approach (undirected graphs)." << std::endl;
+    std::cout <<"-b" << std::endl;
+    std::cout <<"          Use bidirectional shortest path computations in the support vector approach" << std::endl;
+    std::cout <<"          (undirected graphs)." << std::endl;
+    std::cout <<"          When compiled with LEP_STATS the number of settled nodes is reported." << std::endl;
     std::cout <<"-c" << std::endl;
     std::cout <<"          Use the hybrid approach (undirected graphs)." << std::endl;
     std::cout <<"-l" << std::endl;
@@ -109,6 +115,23 @@ void print_usage(const char * program)
     std::cout <<"          parameter. This is not necessarily a minimum cycle basis." << std::endl;
     std::cout <<"          The value parameter must be a prime number." << std::endl;
     std::cout <<"          If this option is given, the option -e is ignored." << std::endl;
+    std::cout <<"          When compiled with MCB_LEP_WORD_PRIMES, primes which fit in a machine word" << std::endl;
+    std::cout <<"          are handled with word arithmetic." << std::endl;
+    std::cout <<"-D" << std::endl;
+    std::cout <<"          Use dense support vectors (exact algorithms)." << std::endl;
+    std::cout <<"-t value" << std::endl;
+    std::cout <<"          Number of threads, zero for all available processors (exact algorithms)." << std::endl;
+    std::cout <<"          Default value is 1." << std::endl;
+    std::cout <<"-M value" << std::endl;
+    std::cout <<"          Memory in bytes for the shortest path trees of the hybrid approach" << std::endl;
+    std::cout <<"          with labelled trees (-l). Default value is 0, that is unbounded." << std::endl;
+    std::cout <<"-Q value" << std::endl;
+    std::cout <<"          Priority queue of the support vector approach: 0 for a binary heap," << std::endl;
+    std::cout <<"          1 for a radix heap and 2 for a bucket queue (-s). Default value is 0." << std::endl;
+    std::cout << std::endl;
+    std::cout << "The options -b, -D, -t, -M and -Q are rejected when they do not apply to the" << std::endl;
+    std::cout << "selected algorithm. If they change the computation the MCB is computed again with" << std::endl;
+    std::cout << "sparse support vectors on a single thread and the two weights are compared." << std::endl;
     std::cout <<"-h" << std::endl;
     std::cout <<"          Display this message." << std::endl;
     std::cout << std::endl;
@@ -156,12 +179,20 @@ int main(int argc, char* argv[]) {
     bool hybrid = false;
     bool weighted = false;
     bool treeshybrid = false;
+    bool bidirectional = false;
     bool printmcb = false;
     bool printdet = false;
     bool printcyclematrix = false;
     bool printhist = false;
     bool approx = false;
     bool directedfp = false;
+    mcb::support_type supporttype = mcb::SPARSE_SUPPORT;
+    int threads = 1;
+    size_t memory = 0;
+    mcb::queue_type queue = mcb::BINARY_HEAP_QUEUE;
+    bool threadsgiven = false;
+    bool memorygiven = false;
+    bool queuegiven = false;
     double errorp = 0.1;
     leda::integer prime;
     int k;
@@ -169,7 +200,7 @@ int main(int argc, char* argv[]) {
 
     opterr = 0;
 
-    while ((c = getopt (argc, argv, "wsmcf:lpdk:qhe:")) != -1)
+    while ((c = getopt (argc, argv, "wsbmcf:lpdk:qhe:Dt:M:Q:")) != -1)
         switch (c)
         {
             case 'w':
@@ -180,6 +211,9 @@ int main(int argc, char* argv[]) {
                 hybrid = false;
                 treeshybrid = false;
                 break;
+            case 'b':
+                bidirectional = true;
+                break;
             case 'c':
                 support = false;
                 hybrid = true;
@@ -222,6 +256,34 @@ int main(int argc, char* argv[]) {
                 else 
                     directedfp = true;
                 break;
+            case 'D':
+                supporttype = mcb::DENSE_SUPPORT;
+                break;
+            case 't':
+                threads = atoi( optarg );
+                threadsgiven = true;
+                break;
+            case 'M':
+                memory = (size_t) atof( optarg );
+                memorygiven = true;
+                break;
+            case 'Q':
+                switch( atoi( optarg ) ) { 
+                    case 0: 
+                        queue = mcb::BINARY_HEAP_QUEUE;
+                        break;
+                    case 1: 
+                        queue = mcb::RADIX_HEAP_QUEUE;
+                        break;
+                    case 2:
+                        queue = mcb::BUCKET_QUEUE;
+                        break;
+                    default:
+                        std::cerr << "-Q parameter value should be 0, 1 or 2, aborting.." << std::endl;
+                        exit( EXIT_FAILURE );
+                }
+                queuegiven = true;
+                break;
             case 'h':
             default:
                 print_usage( argv[0] );
@@ -241,6 +303,26 @@ int main(int argc, char* argv[]) {
         abort();
     }
 
+    // reject the options which the selected algorithm does not take
+    bool exact = ! approx && ( ! G.is_undirected() || support || hybrid || treeshybrid );
+    bool sva = G.is_undirected() && ! approx && support;
+    bool fh = G.is_undirected() && ! approx && treeshybrid;
+    std::string rejected;
+    if ( bidirectional && ! sva ) 
+        rejected += " -b";
+    if ( supporttype == mcb::DENSE_SUPPORT && ! exact ) 
+        rejected += " -D";
+    if ( threadsgiven && ! exact ) 
+        rejected += " -t";
+    if ( memorygiven && ! fh ) 
+        rejected += " -M";
+    if ( queuegiven && ! sva ) 
+        rejected += " -Q";
+    if ( ! rejected.empty() ) { 
+        std::cerr << "Options not applicable to the selected algorithm:" << rejected << ", aborting.." << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // copy from map to edge array
     edge e;
     edge_array<int> len( G, 1 );
@@ -269,10 +351,12 @@ int main(int argc, char* argv[]) {
                 print_histogram( G, len, mcb, enumb );
         }
         else if ( support ) { 
-            std::cout << "Computing undirected MCB with Support Vector approach." << std::endl;
+            std::cout << "Computing undirected MCB with Support Vector approach";
+            std::cout << ( bidirectional ? " and bidirectional searches." : "." ) << std::endl;
             array< mcb::spvecgf2 > mcb;
             array< mcb::spvecgf2 > proof;
-            w = mcb::UMCB_SVA( G, len, mcb, proof, enumb );
+            w = mcb::UMCB_SVA( G, len, mcb, proof, enumb, supporttype, threads, 
+                    bidirectional ? mcb::BIDIRECTIONAL_SEARCH : mcb::UNIDIRECTIONAL_SEARCH, queue );
             print_det_and_matrix( G, mcb, enumb, printdet, printcyclematrix );
             if (printmcb)
                 for( int i = 0; i < enumb.dim_cycle_space(); ++i )
@@ -284,7 +368,7 @@ int main(int argc, char* argv[]) {
             std::cout << "Computing undirected MCB with Hybrid approach." << std::endl;
             array< leda::d_int_set > mcb;
             array< leda::d_int_set > proof;
-            w = mcb::UMCB_HYBRID( G, len, mcb, proof, enumb );
+            w = mcb::UMCB_HYBRID( G, len, mcb, proof, enumb, supporttype, threads );
             print_det_and_matrix( G, mcb, enumb, printdet, printcyclematrix );
             if (printmcb)
                 for( int i = 0; i < enumb.dim_cycle_space(); ++i )
@@ -296,7 +380,7 @@ int main(int argc, char* argv[]) {
             std::cout << "Computing undirected MCB with Hybrid + Labelled Trees approach." << std::endl;
             array< mcb::spvecgf2 > mcb;
             array< mcb::spvecgf2 > proof;
-            w = mcb::UMCB_FH( G, len, mcb, enumb );
+            w = mcb::UMCB_FH( G, len, mcb, enumb, supporttype, threads, memory );
             print_det_and_matrix( G, mcb, enumb, printdet, printcyclematrix );
             if (printmcb)
                 for( int i = 0; i < enumb.dim_cycle_space(); ++i )
@@ -337,9 +421,9 @@ int main(int argc, char* argv[]) {
         }
         else { 
             if ( directedfp )
-                w = mcb::DMCB<int>( G, len, mcb, proof, enumb, prime );
+                w = mcb::DMCB<int>( G, len, mcb, proof, enumb, prime, supporttype, threads );
             else
-                w = mcb::DMCB<int>( G, len, mcb, proof, enumb, errorp );
+                w = mcb::DMCB<int>( G, len, mcb, proof, enumb, errorp, supporttype, threads );
         }
 
         print_det_and_matrix( G, mcb, enumb, printdet, printcyclematrix );
@@ -371,6 +455,47 @@ int main(int argc, char* argv[]) {
     std::cout << "weight: " << w << std::endl;
     std::cout << "time to compute: " << T << std::endl;
 
+    // compare with the computation using sparse support vectors on a single thread, 
+    // only the algorithms which accept the options get here
+    bool reference = bidirectional || supporttype != mcb::SPARSE_SUPPORT || threads != 1 || 
+        memory != 0 || queue != mcb::BINARY_HEAP_QUEUE;
+    if ( reference ) { 
+        int wref;
+        if ( G.is_undirected() ) { 
+            if ( support ) { 
+                array< mcb::spvecgf2 > mcb;
+                wref = mcb::UMCB_SVA( G, len, mcb, enumb );
+            }
+            else if ( hybrid ) { 
+                array< leda::d_int_set > mcb;
+                array< leda::d_int_set > proof;
+                wref = mcb::UMCB_HYBRID( G, len, mcb, proof, enumb );
+            }
+            else { 
+                array< mcb::spvecgf2 > mcb;
+                wref = mcb::UMCB_FH( G, len, mcb, enumb );
+            }
+        }
+        else { 
+            array< mcb::spvecfp > mcb;
+            array< mcb::spvecfp > proof;
+            if ( directedfp )
+                wref = mcb::DMCB<int>( G, len, mcb, proof, enumb, prime );
+            else
+                wref = mcb::DMCB<int>( G, len, mcb, proof, enumb, errorp );
+        }
+
+        std::cout << "weight with sparse support vectors on a single thread: " << wref << std::endl;
+        if ( wref != w ) { 
+            // the directed algorithm is randomized, without -f a basis may not be minimum
+            if ( G.is_undirected() || directedfp ) { 
+                std::cerr << "Error: the weights differ!" << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << "The weights differ, one of the bases is not minimum." << std::endl;
+        }
+    }
+
     return 0;
 }
 
@@ -0,0 +1,170 @@
+//
+// This program can be freely used in an academic environment
+// ONLY for research purposes, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    an acknowledgment in the product documentation is required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Any other use is strictly prohibited by the author, without an explicit 
+// permission.
+//
+// Note that this program uses the LEDA library, which is NOT free. For more 
+// details visit Algorithmic Solutions at http://www.algorithmic-solutions.com/
+// There is also a free version of LEDA 6.0 or newer.
+//
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+// ! Any commercial use of this software is strictly !
+// ! prohibited without explicit permission by the   !
+// ! author.                                         !
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+//
+// This software is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Copyright (C) 2004-2008 - Dimitrios Michail <dimitrios.michail@gmail.com>
+//
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <vector>
+#include <LEP/mcb/umcb.h>
+
+#if defined(LEDA_NAMESPACE)
+using namespace leda;
+#endif
+
+// Benchmark of the shortest path computations of the support vector approach 
+// on road like graphs. The graph is a grid with random integer edge lengths, 
+// from which every edge is removed with probability 1/10. The MCB is computed 
+// with unidirectional and bidirectional searches and with each priority queue.
+// When compiled with LEP_STATS the library also reports the number of settled 
+// nodes of each run.
+
+// Elapsed time in seconds. The CPU time of leda::used_time() would add up the 
+// time of all the threads.
+double wall_time()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+void print_usage(const char * program)
+{
+    std::cout << "Usage: "<< program <<" [-n value] [-w value] [-r value] [-t value]" << std::endl;
+    std::cout << "Compute the MCB of a random grid graph with the different shortest path" << std::endl;
+    std::cout << "computations of the support vector approach and report their elapsed" << std::endl;
+    std::cout << "(wall clock) running times." << std::endl;
+    std::cout << std::endl;
+    std::cout <<"-n value" << std::endl;
+    std::cout <<"          The grid has value x value nodes. Default value is 30." << std::endl;
+    std::cout <<"-w value" << std::endl;
+    std::cout <<"          Edge lengths are chosen uniformly in [10,value). Default value is 100." << std::endl;
+    std::cout <<"-r value" << std::endl;
+    std::cout <<"          Seed of the random number generator. Default value is 7." << std::endl;
+    std::cout <<"-t value" << std::endl;
+    std::cout <<"          Number of threads, zero for all available processors. Default value is 1." << std::endl;
+    std::cout <<"-h" << std::endl;
+    std::cout <<"          Display this message." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+
+    int rows = 30;
+    int maxlen = 100;
+    int seed = 7;
+    int threads = 1;
+    int c;
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "n:w:r:t:h")) != -1)
+        switch (c)
+        {
+            case 'n':
+                rows = atoi( optarg );
+                if ( rows < 2 ) 
+                    rows = 2;
+                break;
+            case 'w':
+                maxlen = atoi( optarg );
+                if ( maxlen <= 10 ) 
+                    maxlen = 11;
+                break;
+            case 'r':
+                seed = atoi( optarg );
+                break;
+            case 't':
+                threads = atoi( optarg );
+                break;
+            case 'h':
+            default:
+                print_usage( argv[0] );
+                exit( EXIT_SUCCESS );
+        }
+
+    // create the grid
+    graph G;
+    std::vector<node> V( rows * rows );
+    for( int i = 0; i < rows * rows; ++i ) 
+        V[i] = G.new_node();
+
+    srand( seed );
+    for( int i = 0; i < rows; ++i ) 
+        for( int j = 0; j < rows; ++j ) { 
+            if ( j + 1 < rows && rand() % 10 != 0 ) 
+                G.new_edge( V[ i * rows + j ], V[ i * rows + j + 1 ] );
+            if ( i + 1 < rows && rand() % 10 != 0 ) 
+                G.new_edge( V[ i * rows + j ], V[ ( i + 1 ) * rows + j ] );
+        }
+    G.make_undirected();
+
+    edge e;
+    edge_array<int> len( G );
+    forall_edges( e, G ) 
+        len[ e ] = 10 + rand() % ( maxlen - 10 );
+
+    mcb::edge_num enumb( G );
+    std::cout << "grid " << rows << "x" << rows << ", nodes: " << G.number_of_nodes();
+    std::cout << ", edges: " << G.number_of_edges();
+    std::cout << ", dimension of cycle space: " << enumb.dim_cycle_space() << std::endl;
+
+    const char* searchname[] = { "unidirectional", "bidirectional" };
+    const mcb::search_type search[] = { mcb::UNIDIRECTIONAL_SEARCH, mcb::BIDIRECTIONAL_SEARCH };
+    const char* queuename[] = { "binary heap", "radix heap", "bucket queue" };
+    const mcb::queue_type queue[] = { mcb::BINARY_HEAP_QUEUE, mcb::RADIX_HEAP_QUEUE, mcb::BUCKET_QUEUE };
+
+    int w0 = 0;
+    bool same = true;
+    for( int s = 0; s < 2; ++s ) 
+        for( int q = 0; q < 3; ++q ) { 
+            array< mcb::spvecgf2 > mcb;
+            double T = wall_time(); // start time
+            int w = mcb::UMCB_SVA( G, len, mcb, enumb, mcb::SPARSE_SUPPORT, threads, search[s], queue[q] );
+            T = wall_time() - T; // finish time
+
+            std::cout << searchname[s] << " search, " << queuename[q] << ": weight " << w;
+            std::cout << ", time " << T << std::endl;
+
+            if ( s == 0 && q == 0 ) 
+                w0 = w;
+            else if ( w != w0 ) 
+                same = false;
+        }
+
+    if ( ! same ) { 
+        std::cerr << "The MCB weights differ!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/* ex: set ts=4 sw=4 sts=4 et: */